@@ -0,0 +1,101 @@
+{-# LANGUAGE ForeignFunctionInterface #-}
+-- bindings to the C interface of the C++ implementation (src/descartes_c.h),
+-- link against the library built by Descartes_Polinom_C.vcxproj (needs the vector package)
+
+module DescartesFFI where
+
+import Foreign
+import Foreign.C.Types
+import Foreign.Marshal.Array
+import System.IO.Unsafe (unsafePerformIO)
+import qualified Data.Vector.Storable as VS
+
+type Interval = (Double, Double)
+
+data CWorkspace
+type Workspace = ForeignPtr CWorkspace
+
+foreign import ccall unsafe "descartes_workspace_create"
+    c_workspace_create :: CSize -> IO (Ptr CWorkspace)
+foreign import ccall unsafe "&descartes_workspace_destroy"
+    c_workspace_destroy :: FunPtr (Ptr CWorkspace -> IO ())
+foreign import ccall unsafe "descartes_isolate"
+    c_isolate :: Ptr CWorkspace -> Ptr CDouble -> CSize -> CDouble -> CDouble -> CDouble
+              -> Ptr CDouble -> CSize -> Ptr CSize -> IO CInt
+foreign import ccall unsafe "descartes_refine"
+    c_refine :: Ptr CDouble -> CSize -> Ptr CDouble -> CDouble -> IO CInt
+foreign import ccall unsafe "descartes_to_bernstein"
+    c_to_bernstein :: Ptr CDouble -> CSize -> CDouble -> CDouble -> Ptr CDouble -> IO CInt
+foreign import ccall unsafe "descartes_evaluate"
+    c_evaluate :: Ptr CDouble -> CSize -> CDouble -> IO CDouble
+
+-- status codes as in descartes_status
+statusOk, statusBufferTooSmall :: CInt
+statusOk             = 0
+statusBufferTooSmall = 2
+
+-- the workspace is freed by the garbage collector, it may only be used by one thread at a time
+newWorkspace :: Int -> IO Workspace
+newWorkspace maxDegree = c_workspace_create (fromIntegral maxDegree) >>= newForeignPtr c_workspace_destroy
+
+-- the buffer of the vector is handed to C as it is (CDouble has the representation of Double), nothing is copied
+withCoeffs :: VS.Vector Double -> (CSize -> Ptr CDouble -> IO a) -> IO a
+withCoeffs coeffs f = VS.unsafeWith coeffs $ \ptr -> f (fromIntegral (VS.length coeffs)) (castPtr ptr)
+
+-- count doubles written by fill into a fresh buffer, which becomes the result vector without a copy
+createVector :: Int -> (Ptr CDouble -> IO a) -> IO (a, VS.Vector Double)
+createVector count fill = do
+    buffer <- mallocForeignPtrArray (max 1 count)
+    result <- withForeignPtr buffer fill
+    return (result, VS.unsafeFromForeignPtr0 (castForeignPtr buffer) count)
+
+-- coefficients in little endian as in Monomials.
+-- result is [min_0, max_0, min_1, max_1, ...], written by C directly into the buffer of the vector
+isolateVector :: Workspace -> VS.Vector Double -> Interval -> Double -> IO (VS.Vector Double)
+isolateVector ws coeffs (a, b) minWidth =
+    withForeignPtr ws $ \wsPtr ->
+    withCoeffs coeffs $ \count coeffPtr ->
+    alloca $ \foundPtr ->
+    let run capacity = do
+            (status, out) <- createVector (2 * capacity) $ \outPtr ->
+                c_isolate wsPtr coeffPtr count (realToFrac a) (realToFrac b) (realToFrac minWidth) outPtr (fromIntegral capacity) foundPtr
+            found <- fromIntegral <$> peek foundPtr
+            case status of
+                s | s == statusOk             -> return (VS.take (2 * found) out)
+                  | s == statusBufferTooSmall -> run found
+                  | otherwise                 -> ioError (userError ("descartes_isolate failed with " ++ show s))
+    in run (max 1 (fromIntegral count))
+
+refineVector :: VS.Vector Double -> Interval -> Double -> Maybe Interval
+refineVector coeffs (a, b) width = unsafePerformIO $
+    withCoeffs coeffs $ \count coeffPtr ->
+    withArray [realToFrac a, realToFrac b] $ \intervalPtr -> do
+        status <- c_refine coeffPtr count intervalPtr (realToFrac width)
+        [a', b'] <- map realToFrac <$> peekArray 2 intervalPtr
+        return (if status == statusOk then Just (a', b') else Nothing)
+
+bernsteinVector :: VS.Vector Double -> Interval -> VS.Vector Double
+bernsteinVector coeffs (a, b) = unsafePerformIO $
+    withCoeffs coeffs $ \count coeffPtr ->
+    snd <$> createVector (fromIntegral count) (c_to_bernstein coeffPtr count (realToFrac a) (realToFrac b))
+
+evaluateVector :: VS.Vector Double -> Double -> Double
+evaluateVector coeffs x = unsafePerformIO $
+    withCoeffs coeffs $ \count coeffPtr ->
+    realToFrac <$> c_evaluate coeffPtr count (realToFrac x)
+
+-- conveniences for lists, they copy the coefficients once into a vector
+
+isolate :: Workspace -> [Double] -> Interval -> Double -> IO [Interval]
+isolate ws coeffs range minWidth = toPairs . VS.toList <$> isolateVector ws (VS.fromList coeffs) range minWidth
+    where toPairs (x:y:rest) = (x, y) : toPairs rest
+          toPairs _          = []
+
+refine :: [Double] -> Interval -> Double -> Maybe Interval
+refine coeffs = refineVector (VS.fromList coeffs)
+
+bernsteinCoeffs :: [Double] -> Interval -> [Double]
+bernsteinCoeffs coeffs range = VS.toList (bernsteinVector (VS.fromList coeffs) range)
+
+evaluate :: [Double] -> Double -> Double
+evaluate coeffs = evaluateVector (VS.fromList coeffs)
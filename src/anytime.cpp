@@ -0,0 +1,76 @@
+#include "anytime.hpp"
+
+using namespace polynomial;
+
+namespace anytime {
+
+	//the clock is read every clock_stride nodes only (must be a power of two)
+	constexpr std::size_t clock_stride = 64;
+
+} //namespace anytime
+
+Anytime_Result anytime_root_isolation(const Bernstein& polynomial, const Anytime_Settings& settings)
+{
+	using Clock = std::chrono::steady_clock;
+	const Clock::time_point start = Clock::now();
+	Clock::time_point next_progress = start + settings.progress_interval;
+
+	Anytime_Result result = { {}, {}, Stop_Reason::finished, 0 };
+	std::vector<Bernstein> stack = { polynomial };
+	while (!stack.empty()) {
+		if (result.nodes >= settings.max_nodes) {
+			result.reason = Stop_Reason::node_budget;
+			break;
+		}
+		if (settings.cancel && settings.cancel->load(std::memory_order_relaxed)) {
+			result.reason = Stop_Reason::cancelled;
+			break;
+		}
+		if ((result.nodes & (anytime::clock_stride - 1)) == 0) {
+			const Clock::time_point now = Clock::now();
+			if (now >= settings.deadline) {
+				result.reason = Stop_Reason::deadline;
+				break;
+			}
+			if (settings.progress && now >= next_progress) {
+				settings.progress(Anytime_Progress{ result.nodes, result.roots.size(), stack.size(), now - start });
+				next_progress = now + settings.progress_interval;
+			}
+		}
+
+		Bernstein current = std::move(stack.back());
+		stack.pop_back();
+		result.nodes++;
+		const std::size_t variations = number_sign_changes(current);
+		if (variations == 0) {
+			continue;
+		}
+		if (variations == 1) {
+			result.roots.push_back(current.interval);
+			continue;
+		}
+		const double middle = current.interval.min / 2 + current.interval.max / 2;
+		const bool splittable = current.interval.min < middle && middle < current.interval.max;
+		if (current.interval.width() < settings.min_width || !splittable) {
+			result.unresolved.push_back(Frontier_Leaf{ current.interval, variations });
+			continue;
+		}
+		auto [lower, upper] = de_casteljau_split(current);
+		stack.push_back(std::move(upper));	//lower half is processed first
+		stack.push_back(std::move(lower));
+	}
+
+	//the stack holds the pending nodes right to left, all of them lie right of everything decided so far
+	for (auto node = stack.rbegin(); node != stack.rend(); ++node) {
+		const std::size_t variations = number_sign_changes(*node);
+		if (variations != 0) {
+			result.unresolved.push_back(Frontier_Leaf{ node->interval, variations });
+		}
+	}
+	return result;
+}
+
+Anytime_Result anytime_root_isolation(const Monomials& polinomial, const Interval& start_zone, const Anytime_Settings& settings)
+{
+	return anytime_root_isolation(to_bernstein(polinomial, start_zone), settings);
+}
@@ -0,0 +1,56 @@
+#pragma once
+
+#include <vector>
+#include <atomic>
+#include <chrono>
+#include <functional>
+#include <limits>
+
+#include "descartes.hpp"
+
+//snapshot of a running anytime_root_isolation
+struct Anytime_Progress
+{
+	std::size_t nodes;			//nodes of the subdivision tree processed so far
+	std::size_t roots;			//certified intervals found so far
+	std::size_t pending;		//nodes still waiting to be processed
+	std::chrono::steady_clock::duration elapsed;
+};
+
+//limits of anytime_root_isolation, the defaults impose none
+struct Anytime_Settings
+{
+	std::chrono::steady_clock::time_point deadline = std::chrono::steady_clock::time_point::max();
+	std::size_t max_nodes = std::numeric_limits<std::size_t>::max();
+	const std::atomic<bool>* cancel = nullptr;	//checked once per node, may be set from any thread
+
+	//nodes narrower than min_width are not split any more, but go to the unresolved frontier.
+	//with 0 multiple roots are split until doubles can no longer tell the halves apart (or one of the limits above is reached).
+	double min_width = 0.0;
+
+	//called at most once per progress_interval (and not at all if empty).
+	//the clock is read only every few nodes, so the deadline and the callback cost next to nothing in the hot loop
+	std::function<void(const Anytime_Progress&)> progress;
+	std::chrono::steady_clock::duration progress_interval = std::chrono::milliseconds(100);
+};
+
+enum class Stop_Reason { finished, deadline, node_budget, cancelled };
+
+struct Anytime_Result
+{
+	std::vector<Interval> roots;	//certified: exactly one root in each, left to right
+	//everything not decided yet (or narrower than min_width), left to right.
+	//roots is the number of sign changes of the bernstein coefficients, an upper bound on the roots in interval
+	Isolation_Frontier unresolved;
+	Stop_Reason reason;
+	std::size_t nodes;
+};
+
+//same subdivision as descartes_root_isolation for polynomial::Bernstein, but it can be stopped early.
+//together roots and unresolved cover every root of the polynomial in its interval
+//(except roots exactly at a split point, just as in descartes_root_isolation).
+Anytime_Result anytime_root_isolation(const polynomial::Bernstein& polynomial, const Anytime_Settings& settings = {});
+
+//converts polinomial to bernstein base relative to start_zone first
+Anytime_Result anytime_root_isolation(const polynomial::Monomials& polinomial, const Interval& start_zone, 
+	const Anytime_Settings& settings = {});
@@ -0,0 +1,318 @@
+#include "bitstream.hpp"
+
+#include <algorithm>
+#include <array>
+#include <climits>
+
+using namespace multiprecision;
+
+namespace bitstream {
+
+	//closed interval [lower, upper] guaranteed to contain the exact value
+	struct Bounds
+	{
+		Big_Float lower, upper;
+
+		bool is_exact_zero() const { return this->lower.is_zero() && this->upper.is_zero(); }
+	};
+
+	//sign of the exact value, or unknown_sign if zero lies inside the bounds
+	constexpr int unknown_sign = 2;
+
+	int sign(const Bounds& b)
+	{
+		if (b.lower.sign() > 0) { return 1; }
+		if (b.upper.sign() < 0) { return -1; }
+		if (b.is_exact_zero()) { return 0; }
+		return unknown_sign;
+	}
+
+	Bounds add(const Bounds& a, const Bounds& b, std::size_t precision)
+	{
+		return Bounds{
+			multiprecision::add(a.lower, b.lower, precision, Rounding::down),
+			multiprecision::add(a.upper, b.upper, precision, Rounding::up)
+		};
+	}
+
+	Bounds multiply(const Bounds& a, const Bounds& b, std::size_t precision)
+	{
+		const std::array<const Big_Float*, 2> a_ends = { &a.lower, &a.upper };
+		const std::array<const Big_Float*, 2> b_ends = { &b.lower, &b.upper };
+
+		Bounds result = {
+			multiprecision::multiply(a.lower, b.lower, precision, Rounding::down),
+			multiprecision::multiply(a.lower, b.lower, precision, Rounding::up)
+		};
+		for (const auto a_end : a_ends) {
+			for (const auto b_end : b_ends) {
+				const Big_Float lower = multiprecision::multiply(*a_end, *b_end, precision, Rounding::down);
+				const Big_Float upper = multiprecision::multiply(*a_end, *b_end, precision, Rounding::up);
+				if (lower < result.lower) { result.lower = lower; }
+				if (result.upper < upper) { result.upper = upper; }
+			}
+		}
+		return result;
+	}
+
+	Bounds scaled(const Bounds& b, std::int64_t power)
+	{
+		return Bounds{ b.lower.scaled(power), b.upper.scaled(power) };
+	}
+
+	//coefficients[i] becomes coefficient of x^i in p(x + 1), only additions are needed
+	void taylor_shift_by_one(std::vector<Bounds>& coefficients, std::size_t precision)
+	{
+		const std::size_t n = coefficients.size() - 1;
+		for (std::size_t i = 0; i < n; i++) {
+			for (std::size_t j = n - 1; j + 1 > i; j--) {
+				coefficients[j] = add(coefficients[j], coefficients[j + 1], precision);
+			}
+		}
+	}
+
+	//the node represents the part [min, max] of the input polynomial as q(x) = c * p(min + (max - min) * x) on [0, 1]
+	//with some unknown factor c > 0
+	struct Node
+	{
+		Big_Float min, max;
+		std::size_t precision;
+		std::vector<Bounds> coefficients;	//of q in monomial base
+	};
+
+	std::vector<Bounds> approximate_coefficients(const Bitstream_Polynomial& p, std::size_t precision)
+	{
+		std::vector<Bounds> result;
+		result.reserve(p.degree + 1);
+		const Big_Float error = p.exact ? Big_Float() : Big_Float(Big_Int(1), -static_cast<std::int64_t>(precision));
+		for (std::size_t i = 0; i <= p.degree; i++) {
+			const Big_Float approximation = p.approximate(i, precision);
+			result.push_back(Bounds{ approximation - error, approximation + error });
+		}
+		return result;
+	}
+
+	//computes coefficients of p(min + (max - min) * x) from scratch
+	void recompute(Node& node, const Bitstream_Polynomial& p)
+	{
+		const std::size_t prec = node.precision;
+		std::vector<Bounds> c = approximate_coefficients(p, prec);
+		const std::size_t n = p.degree;
+
+		//taylor shift by min
+		const Bounds shift = { node.min, node.min };
+		for (std::size_t i = 0; i < n; i++) {
+			for (std::size_t j = n - 1; j + 1 > i; j--) {
+				c[j] = add(c[j], multiply(shift, c[j + 1], prec), prec);
+			}
+		}
+
+		//scale x with width
+		const Big_Float width = node.max - node.min;
+		const Bounds width_bounds = { width, width };
+		Bounds width_power = { Big_Float(1.0), Big_Float(1.0) };
+		for (std::size_t i = 1; i <= n; i++) {
+			width_power = multiply(width_power, width_bounds, prec);
+			c[i] = multiply(c[i], width_power, prec);
+		}
+		node.coefficients = std::move(c);
+	}
+
+	struct Variation_Bounds
+	{
+		std::size_t min, max;
+	};
+
+	//sign variations of the coefficients, minimized and maximized over all possible signs of undecided coefficients
+	Variation_Bounds sign_variations(const std::vector<Bounds>& coefficients)
+	{
+		//state: last nonzero sign was 0: none yet, 1: positive, 2: negative
+		constexpr int unreachable = INT_MAX;
+		std::array<int, 3> lowest = { 0, unreachable, unreachable };
+		std::array<int, 3> highest = { 0, -1, -1 };
+
+		for (const auto& coefficient : coefficients) {
+			const int s = sign(coefficient);
+			if (s == 0) {
+				continue;
+			}
+			const std::vector<int> options = s == unknown_sign ? std::vector<int>{ 0, 1, -1 } : std::vector<int>{ s };
+
+			std::array<int, 3> new_lowest = { unreachable, unreachable, unreachable };
+			std::array<int, 3> new_highest = { -1, -1, -1 };
+			for (int state = 0; state < 3; state++) {
+				if (lowest[state] == unreachable) {
+					continue;
+				}
+				for (const int option : options) {
+					const int new_state = option == 0 ? state : (option > 0 ? 1 : 2);
+					const int change = (state != 0 && new_state != state) ? 1 : 0;
+					new_lowest[new_state] = std::min(new_lowest[new_state], lowest[state] + change);
+					new_highest[new_state] = std::max(new_highest[new_state], highest[state] + change);
+				}
+			}
+			lowest = new_lowest;
+			highest = new_highest;
+		}
+		return Variation_Bounds{
+			static_cast<std::size_t>(*std::min_element(lowest.begin(), lowest.end())),
+			static_cast<std::size_t>(*std::max_element(highest.begin(), highest.end()))
+		};
+	}
+
+	//descartes rule of signs on (1 + x)^n * q(1 / (1 + x)), which has as many positive roots as q has in (0, 1)
+	Variation_Bounds descartes_test(const Node& node)
+	{
+		std::vector<Bounds> transformed(node.coefficients.rbegin(), node.coefficients.rend());
+		taylor_shift_by_one(transformed, node.precision);
+		return sign_variations(transformed);
+	}
+
+	Bounds evaluate(const std::vector<Bounds>& coefficients, const Big_Float& x, std::size_t precision)
+	{
+		const Bounds x_bounds = { x, x };
+		Bounds result = coefficients.back();
+		for (std::size_t i = coefficients.size() - 1; i > 0; i--) {
+			result = add(multiply(result, x_bounds, precision), coefficients[i - 1], precision);
+		}
+		return result;
+	}
+
+	//splits at min + t * (max - min) with t in (0, 1) dyadic
+	std::pair<Node, Node> split(const Node& node, const Big_Float& t)
+	{
+		const std::size_t n = node.coefficients.size() - 1;
+		const std::size_t prec = node.precision;
+		const Big_Float split_point = node.min + t * (node.max - node.min);
+		const bool at_midpoint = t == Big_Float(0.5);
+
+		//left part: q(t * x), at the midpoint scaled with 2^n to stay exact
+		Node left = { node.min, split_point, prec, node.coefficients };
+		Bounds t_power = { Big_Float(1.0), Big_Float(1.0) };
+		for (std::size_t i = 0; i <= n; i++) {
+			if (at_midpoint) {
+				left.coefficients[i] = scaled(left.coefficients[i], static_cast<std::int64_t>(n - i));
+			}
+			else {
+				left.coefficients[i] = multiply(left.coefficients[i], t_power, prec);
+				t_power = multiply(t_power, Bounds{ t, t }, prec);
+			}
+		}
+
+		//right part: q(t + (1 - t) * x), at the midpoint this is just 2^n * q((x + 1) / 2)
+		Node right = { split_point, node.max, prec, {} };
+		if (at_midpoint) {
+			right.coefficients = left.coefficients;
+			taylor_shift_by_one(right.coefficients, prec);
+		}
+		else {
+			right.coefficients = node.coefficients;
+			const Bounds shift = { t, t };
+			for (std::size_t i = 0; i < n; i++) {
+				for (std::size_t j = n - 1; j + 1 > i; j--) {
+					right.coefficients[j] = add(right.coefficients[j], multiply(shift, right.coefficients[j + 1], prec), prec);
+				}
+			}
+			const Big_Float rest = Big_Float(1.0) - t;
+			Bounds rest_power = { Big_Float(1.0), Big_Float(1.0) };
+			for (std::size_t i = 1; i <= n; i++) {
+				rest_power = multiply(rest_power, Bounds{ rest, rest }, prec);
+				right.coefficients[i] = multiply(right.coefficients[i], rest_power, prec);
+			}
+		}
+		return std::make_pair(std::move(left), std::move(right));
+	}
+
+	//if the coefficients are only approximations, a root exactly at the split point would leave both children
+	//undecidable forever. thus the midpoint is only used, if the sign of q is certain there,
+	//else the first point close by with a certain sign is taken (Sagraloff does the same with random points).
+	Big_Float choose_split(const Node& node)
+	{
+		const std::array<std::int64_t, 5> numerators_of_16th = { 8, 7, 9, 6, 10 };
+		for (const auto numerator : numerators_of_16th) {
+			const Big_Float t = Big_Float(Big_Int(numerator), -4);
+			if (sign(evaluate(node.coefficients, t, node.precision)) != unknown_sign) {
+				return t;
+			}
+		}
+		return Big_Float(0.5);
+	}
+
+	Interval to_interval(const Big_Float& min, const Big_Float& max)
+	{
+		return Interval{ min.to_double(Rounding::down), max.to_double(Rounding::up) };
+	}
+
+} //namespace bitstream
+
+Bitstream_Polynomial to_bitstream(const polynomial::Monomials& p)
+{
+	const auto approximate = [p](std::size_t index, std::size_t) {
+		return Big_Float(p[index]);
+	};
+	return Bitstream_Polynomial{ static_cast<std::size_t>(p.degree()), approximate, true };
+}
+
+std::vector<Interval> bitstream_root_isolation(const Bitstream_Polynomial& p, const Interval& start_zone,
+	std::size_t start_precision, std::size_t max_precision, Isolation_Frontier* uncertain)
+{
+	using namespace bitstream;
+
+	std::vector<Interval> root_intervals;
+	root_intervals.reserve(p.degree);
+
+	Node start = { Big_Float(start_zone.min), Big_Float(start_zone.max), start_precision, {} };
+	recompute(start, p);
+
+	//descartes test only sees open intervals, so roots at node boundaries are checked separately:
+	//every node terminating with q(0) == 0 reports its min, the max of start_zone is checked here.
+	if (p.exact && sign(evaluate(approximate_coefficients(p, exact), Big_Float(start_zone.max), exact)) == 0) {
+		root_intervals.push_back(Interval{ start_zone.max, start_zone.max });
+	}
+	const auto report_root_at_min = [&root_intervals](const Node& node) {
+		if (node.coefficients[0].is_exact_zero()) {
+			root_intervals.push_back(to_interval(node.min, node.min));
+		}
+	};
+
+	std::vector<Node> search_nodes;
+	search_nodes.push_back(std::move(start));
+
+	while (search_nodes.size()) {
+		Node current = std::move(search_nodes.back());
+		search_nodes.pop_back();
+
+		const auto [min_variations, max_variations] = descartes_test(current);
+		const bool decided = min_variations == max_variations;
+
+		if (max_variations == 0) {
+			report_root_at_min(current);	//throw away current
+		}
+		else if (decided && max_variations == 1) {
+			report_root_at_min(current);
+			root_intervals.push_back(to_interval(current.min, current.max));
+		}
+		else if (min_variations >= 2 || (!decided && current.precision * 2 > max_precision && max_variations >= 2)) {
+			auto [left, right] = split(current, choose_split(current));
+			search_nodes.push_back(std::move(left));
+			search_nodes.push_back(std::move(right));
+		}
+		else if (current.precision * 2 <= max_precision) {	//not enough precision to decide
+			current.precision *= 2;
+			recompute(current, p);
+			search_nodes.push_back(std::move(current));
+		}
+		else {	//at most one root, but precision is exhausted
+			report_root_at_min(current);
+			if (uncertain) {
+				uncertain->push_back(Frontier_Leaf{ to_interval(current.min, current.max), max_variations });
+			}
+		}
+	}
+	return root_intervals;
+}
+
+std::vector<Interval> bitstream_root_isolation(const polynomial::Monomials& p, const Interval& start_zone, Isolation_Frontier* uncertain)
+{
+	return bitstream_root_isolation(to_bitstream(p), start_zone, 64, 1 << 14, uncertain);
+}
@@ -0,0 +1,32 @@
+#pragma once
+
+#include <functional>
+
+#include "descartes.hpp"
+#include "multiprecision.hpp"
+
+//polynomial in the bitstream model: coefficients need not be known exactly, but can be approximated to any precision
+//approximate(i, precision) returns the coefficient of x^i with an absolute error of at most 2^-precision
+struct Bitstream_Polynomial
+{
+	std::size_t degree;
+	std::function<multiprecision::Big_Float(std::size_t index, std::size_t precision)> approximate;
+	bool exact = false;	//set, if approximate always returns the exact coefficient (e.g. for doubles)
+};
+
+Bitstream_Polynomial to_bitstream(const polynomial::Monomials& p);
+
+//bitstream descartes (Eigenwillig, Sagraloff): returns intervals with exactly one root of p in each
+//each node is evaluated in interval arithmetic with the working precision of its parent.
+//only if a sign variation count can not be decided, the precision of that node is doubled and
+//its coefficients are recomputed from fresh approximations, so the cost grows with the conditioning of p.
+//roots lying exactly on a split point are returned as Interval{ x, x }, all other intervals are rounded outwards to doubles.
+//(will not terminate if polynomial has roots with multiplicity > 1, same as descartes_root_isolation)
+//if a node still can not be decided with max_precision, it is split if it may hold more than one root.
+//a node which may hold one root or none is never part of the result, but is appended to uncertain (if given)
+//with roots = 1 as upper bound. without uncertain such nodes are dropped, the result then may miss a root.
+std::vector<Interval> bitstream_root_isolation(const Bitstream_Polynomial& p, const Interval& start_zone,
+	std::size_t start_precision = 64, std::size_t max_precision = 1 << 14, Isolation_Frontier* uncertain = nullptr);
+
+std::vector<Interval> bitstream_root_isolation(const polynomial::Monomials& p, const Interval& start_zone,
+	Isolation_Frontier* uncertain = nullptr);
@@ -0,0 +1,198 @@
+#include "cache.hpp"
+
+#include <fstream>
+#include <algorithm>
+#include <cstring>
+
+using namespace polynomial;
+
+namespace cache {
+
+	constexpr char file_magic[8] = { 'D', 'P', 'C', 'A', 'C', 'H', 'E', '1' };
+
+	//FNV-1a over the bytes of the doubles
+	void hash_doubles(std::uint64_t& hash, const double* values, std::size_t count)
+	{
+		for (std::size_t i = 0; i < count; i++) {
+			const double value = values[i] == 0.0 ? 0.0 : values[i];	//-0.0 and 0.0 compare equal, so they must hash equal
+			unsigned char bytes[sizeof(double)];
+			std::memcpy(bytes, &value, sizeof(double));
+			for (const unsigned char byte : bytes) {
+				hash = (hash ^ byte) * 0x100000001b3;
+			}
+		}
+	}
+
+	template<typename T>
+	void write(std::ofstream& file, const T& value) { file.write(reinterpret_cast<const char*>(&value), sizeof(T)); }
+
+	template<typename T>
+	T read(std::ifstream& file)
+	{
+		T value;
+		if (!file.read(reinterpret_cast<char*>(&value), sizeof(T))) {
+			throw std::exception("cache file ends unexpectedly");
+		}
+		return value;
+	}
+
+} //namespace cache
+
+bool Isolation_Cache::Key::operator==(const Key& other) const
+{
+	return this->hash == other.hash && this->accept_tag == other.accept_tag &&
+		this->start_zone.min == other.start_zone.min && this->start_zone.max == other.start_zone.max &&
+		this->coefficients == other.coefficients;
+}
+
+Isolation_Cache::Key Isolation_Cache::make_key(const Monomials& p, const Interval& start_zone, std::uint64_t accept_tag)
+{
+	if (std::all_of(p.begin(), p.end(), [](double c) { return c == 0.0; })) {
+		throw std::exception("the zero polynomial has no isolated roots");
+	}
+	Monomials normalized = p;
+	normalize(normalized);
+	std::size_t size = normalized.size();
+	while (size > 1 && normalized[size - 1] == 0.0) {
+		size--;
+	}
+
+	Key key = { std::vector<double>(normalized.begin(), normalized.begin() + size), start_zone, accept_tag, 0 };
+	std::uint64_t hash = 0xcbf29ce484222325;
+	cache::hash_doubles(hash, key.coefficients.data(), key.coefficients.size());
+	cache::hash_doubles(hash, &key.start_zone.min, 1);
+	cache::hash_doubles(hash, &key.start_zone.max, 1);
+	hash = (hash ^ accept_tag) * 0x100000001b3;
+	//the low bits choose the shard, but only depend on the low bits of every byte so far (murmur3 finalizer)
+	hash ^= hash >> 33;
+	hash *= 0xff51afd7ed558ccd;
+	hash ^= hash >> 33;
+	key.hash = static_cast<std::size_t>(hash);
+	return key;
+}
+
+std::optional<std::vector<Interval>> Isolation_Cache::find(const Key& key)
+{
+	Shard& shard = this->shard_of(key);
+	std::lock_guard lock(shard.mutex);
+	const auto found = shard.index.find(key);
+	if (found == shard.index.end()) {
+		this->misses++;
+		return std::nullopt;
+	}
+	this->hits++;
+	shard.entries.splice(shard.entries.begin(), shard.entries, found->second);
+	return found->second->intervals;
+}
+
+void Isolation_Cache::insert(Key&& key, const std::vector<Interval>& intervals)
+{
+	Shard& shard = this->shard_of(key);
+	std::lock_guard lock(shard.mutex);
+	const auto found = shard.index.find(key);
+	if (found != shard.index.end()) {
+		found->second->intervals = intervals;
+		shard.entries.splice(shard.entries.begin(), shard.entries, found->second);
+		return;
+	}
+	if (shard.entries.size() >= this->shard_capacity) {
+		shard.index.erase(shard.entries.back().key);
+		shard.entries.pop_back();
+		this->evictions++;
+	}
+	shard.entries.push_front(Entry{ std::move(key), intervals });
+	shard.index.emplace(shard.entries.front().key, shard.entries.begin());
+}
+
+Isolation_Cache::Isolation_Cache(std::size_t capacity, std::size_t shard_count)
+	:shard_capacity(std::max<std::size_t>(capacity / std::max<std::size_t>(shard_count, 1), 1))
+{
+	this->shards.resize(std::max<std::size_t>(shard_count, 1));
+	for (auto& shard : this->shards) {
+		shard = std::make_unique<Shard>();
+	}
+}
+
+std::vector<Interval> Isolation_Cache::root_isolation(const Monomials& p, const Interval& start_zone,
+	bool(*accept)(const Monomials& p, const Interval& i), std::uint64_t accept_tag)
+{
+	if (accept_tag == 0 && accept != default_accept) {
+		throw std::exception("accept functions other than default_accept need their own nonzero tag");
+	}
+	Key key = make_key(p, start_zone, accept_tag);
+	if (std::optional<std::vector<Interval>> cached = this->find(key)) {
+		return std::move(*cached);
+	}
+	std::vector<Interval> intervals = descartes_root_isolation(Monomials(Coefficients(key.coefficients.begin(), key.coefficients.end())), start_zone, accept);
+	this->insert(std::move(key), intervals);
+	return intervals;
+}
+
+std::optional<std::vector<Interval>> Isolation_Cache::find(const Monomials& p, const Interval& start_zone, std::uint64_t accept_tag)
+{
+	return this->find(make_key(p, start_zone, accept_tag));
+}
+
+Cache_Statistics Isolation_Cache::statistics() const
+{
+	std::size_t size = 0;
+	for (const auto& shard : this->shards) {
+		std::lock_guard lock(shard->mutex);
+		size += shard->entries.size();
+	}
+	return Cache_Statistics{ this->hits.load(), this->misses.load(), this->evictions.load(), size };
+}
+
+void Isolation_Cache::clear()
+{
+	for (auto& shard : this->shards) {
+		std::lock_guard lock(shard->mutex);
+		shard->index.clear();
+		shard->entries.clear();
+	}
+}
+
+void Isolation_Cache::save(const std::string& file_name) const
+{
+	std::ofstream file(file_name, std::ios::binary);
+	if (!file) {
+		throw std::exception("could not open cache file for writing");
+	}
+	file.write(cache::file_magic, sizeof(cache::file_magic));
+	for (const auto& shard : this->shards) {
+		std::lock_guard lock(shard->mutex);
+		for (auto entry = shard->entries.rbegin(); entry != shard->entries.rend(); ++entry) {
+			cache::write(file, entry->key.accept_tag);
+			cache::write(file, entry->key.start_zone);
+			cache::write(file, static_cast<std::uint64_t>(entry->key.coefficients.size()));
+			file.write(reinterpret_cast<const char*>(entry->key.coefficients.data()), entry->key.coefficients.size() * sizeof(double));
+			cache::write(file, static_cast<std::uint64_t>(entry->intervals.size()));
+			file.write(reinterpret_cast<const char*>(entry->intervals.data()), entry->intervals.size() * sizeof(Interval));
+		}
+	}
+}
+
+void Isolation_Cache::load(const std::string& file_name)
+{
+	std::ifstream file(file_name, std::ios::binary);
+	char magic[sizeof(cache::file_magic)];
+	if (!file.read(magic, sizeof(magic)) || !std::equal(magic, magic + sizeof(magic), cache::file_magic)) {
+		throw std::exception("not a cache file");
+	}
+	while (file.peek() != std::ifstream::traits_type::eof()) {
+		const std::uint64_t accept_tag = cache::read<std::uint64_t>(file);
+		const Interval start_zone = cache::read<Interval>(file);
+		std::vector<double> coefficients(cache::read<std::uint64_t>(file));
+		for (double& coefficient : coefficients) {
+			coefficient = cache::read<double>(file);
+		}
+		std::vector<Interval> intervals(cache::read<std::uint64_t>(file));
+		for (Interval& interval : intervals) {
+			interval = cache::read<Interval>(file);
+		}
+		if (coefficients.empty()) {
+			throw std::exception("cache file holds an empty polynomial");
+		}
+		this->insert(make_key(Monomials(std::move(coefficients)), start_zone, accept_tag), intervals);
+	}
+}
@@ -0,0 +1,97 @@
+#pragma once
+
+#include <vector>
+#include <list>
+#include <unordered_map>
+#include <memory>
+#include <mutex>
+#include <atomic>
+#include <optional>
+#include <string>
+#include <cstdint>
+
+#include "descartes.hpp"
+
+struct Cache_Statistics
+{
+	std::uint64_t hits;
+	std::uint64_t misses;
+	std::uint64_t evictions;
+	std::size_t size;	//entries currently stored
+
+	double hit_rate() const { return this->hits + this->misses == 0 ? 0.0 : double(this->hits) / double(this->hits + this->misses); }
+};
+
+//results of descartes_root_isolation addressed by their input, so duplicates and scalar multiples of a polynomial
+//are isolated only once. the key is the polynomial after normalize (and without leading zeros), the start zone
+//and a tag naming the accept function. scalar multiples share an entry where normalize rounds them to the same coefficients.
+//the entries are spread over shards by hash, each shard has its own mutex and evicts its least recently used entry when full.
+//all member functions may be called from any number of threads at once.
+class Isolation_Cache
+{
+private:
+	struct Key
+	{
+		std::vector<double> coefficients;	//normalized
+		Interval start_zone;
+		std::uint64_t accept_tag;
+		std::size_t hash;
+
+		bool operator==(const Key& other) const;
+	};
+
+	struct Key_Hash
+	{
+		std::size_t operator()(const Key& key) const { return key.hash; }
+	};
+
+	struct Entry
+	{
+		Key key;
+		std::vector<Interval> intervals;
+	};
+
+	struct Shard
+	{
+		std::mutex mutex;
+		std::list<Entry> entries;	//most recently used first
+		std::unordered_map<Key, std::list<Entry>::iterator, Key_Hash> index;
+	};
+
+	std::size_t shard_capacity;
+	std::vector<std::unique_ptr<Shard>> shards;
+
+	std::atomic<std::uint64_t> hits = 0;
+	std::atomic<std::uint64_t> misses = 0;
+	std::atomic<std::uint64_t> evictions = 0;
+
+	static Key make_key(const polynomial::Monomials& p, const Interval& start_zone, std::uint64_t accept_tag);
+	Shard& shard_of(const Key& key) { return *this->shards[key.hash % this->shards.size()]; }
+	std::optional<std::vector<Interval>> find(const Key& key);
+	void insert(Key&& key, const std::vector<Interval>& intervals);
+
+public:
+	//capacity is the total number of entries, split evenly over the shards
+	Isolation_Cache(std::size_t capacity = 1 << 12, std::size_t shard_count = 16);
+
+	Isolation_Cache(const Isolation_Cache&) = delete;
+	Isolation_Cache& operator=(const Isolation_Cache&) = delete;
+
+	//descartes_root_isolation of the normalized p, taken from the cache if present.
+	//accept_tag identifies accept in the key, 0 is reserved for default_accept (other accept functions with tag 0 throw).
+	//two threads missing the same key at once both compute the result, only one copy is kept.
+	std::vector<Interval> root_isolation(const polynomial::Monomials& p, const Interval& start_zone,
+		bool(*accept)(const polynomial::Monomials& p, const Interval& i) = default_accept, std::uint64_t accept_tag = 0);
+
+	//only looks up, counts as hit or miss
+	std::optional<std::vector<Interval>> find(const polynomial::Monomials& p, const Interval& start_zone, std::uint64_t accept_tag = 0);
+
+	Cache_Statistics statistics() const;
+
+	void clear();
+
+	//binary file of all entries (doubles in the byte order of this machine), most recently used last.
+	//load adds the entries of the file to the cache as if they were inserted in that order, throws if the file is not readable
+	void save(const std::string& file_name) const;
+	void load(const std::string& file_name);
+};
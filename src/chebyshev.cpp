@@ -0,0 +1,224 @@
+#include "chebyshev.hpp"
+#include "isolation_engine.hpp"
+
+#include <cmath>
+#include <complex>
+#include <algorithm>
+#include <cassert>
+
+using namespace polynomial;
+
+namespace chebyshev {
+
+	using Complex = std::complex<double>;
+
+	constexpr double pi = 3.14159265358979323846;
+
+	bool is_power_of_two(std::size_t n) { return n != 0 && (n & (n - 1)) == 0; }
+
+	//iterative radix 2 cooley tukey, data.size() must be a power of two
+	void fft_radix_2(std::vector<Complex>& data, bool inverse)
+	{
+		const std::size_t n = data.size();
+		assert(is_power_of_two(n));
+		for (std::size_t i = 1, j = 0; i < n; i++) {	//bit reversal permutation
+			std::size_t bit = n >> 1;
+			for (; j & bit; bit >>= 1) {
+				j ^= bit;
+			}
+			j ^= bit;
+			if (i < j) {
+				std::swap(data[i], data[j]);
+			}
+		}
+		for (std::size_t length = 2; length <= n; length <<= 1) {
+			const double angle = (inverse ? 2.0 : -2.0) * pi / length;
+			for (std::size_t start = 0; start < n; start += length) {
+				for (std::size_t k = 0; k < length / 2; k++) {
+					const Complex w = std::polar(1.0, angle * k);
+					const Complex even = data[start + k];
+					const Complex odd = data[start + k + length / 2] * w;
+					data[start + k] = even + odd;
+					data[start + k + length / 2] = even - odd;
+				}
+			}
+		}
+		if (inverse) {
+			for (Complex& x : data) {
+				x /= static_cast<double>(n);
+			}
+		}
+	}
+
+	//forward dft of any length. lengths other than powers of two are written as convolution (bluestein),
+	//which is done with power of two ffts of at least twice the size
+	void fft(std::vector<Complex>& data)
+	{
+		const std::size_t n = data.size();
+		if (n <= 1) {
+			return;
+		}
+		if (is_power_of_two(n)) {
+			fft_radix_2(data, false);
+			return;
+		}
+		std::size_t m = 1;
+		while (m < 2 * n - 1) {
+			m <<= 1;
+		}
+		//chirp w_k = exp(-i pi k^2 / n), k^2 is reduced modulo 2n first, so the angle stays exact for large k
+		std::vector<Complex> chirp(n);
+		for (std::size_t k = 0; k < n; k++) {
+			const std::size_t k_squared = (k * k) % (2 * n);
+			chirp[k] = std::polar(1.0, -pi * k_squared / n);
+		}
+		std::vector<Complex> a(m, 0.0);
+		std::vector<Complex> b(m, 0.0);
+		for (std::size_t k = 0; k < n; k++) {
+			a[k] = data[k] * chirp[k];
+		}
+		b[0] = std::conj(chirp[0]);
+		for (std::size_t k = 1; k < n; k++) {
+			b[k] = b[m - k] = std::conj(chirp[k]);
+		}
+		fft_radix_2(a, false);
+		fft_radix_2(b, false);
+		for (std::size_t k = 0; k < m; k++) {
+			a[k] *= b[k];
+		}
+		fft_radix_2(a, true);
+		for (std::size_t k = 0; k < n; k++) {
+			data[k] = a[k] * chirp[k];
+		}
+	}
+
+	//result[j] = \sum_k x[k] * cos(pi * j * (2k + 1) / (2n)) with one complex fft of length n (makhoul)
+	std::vector<double> dct_2(std::span<const double> x)
+	{
+		const std::size_t n = x.size();
+		std::vector<Complex> v(n);
+		for (std::size_t k = 0; 2 * k < n; k++) {
+			v[k] = x[2 * k];
+		}
+		for (std::size_t k = 0; 2 * k + 1 < n; k++) {
+			v[n - 1 - k] = x[2 * k + 1];
+		}
+		fft(v);
+		std::vector<double> result(n);
+		for (std::size_t j = 0; j < n; j++) {
+			result[j] = (v[j] * std::polar(1.0, -pi * j / (2.0 * n))).real();
+		}
+		return result;
+	}
+
+	double to_unit(const Interval& interval, double x)
+	{
+		return (2.0 * x - interval.min - interval.max) / interval.width();
+	}
+
+} //namespace chebyshev
+
+std::vector<double> polynomial::chebyshev_points(std::size_t n, const Interval& interval)
+{
+	std::vector<double> result(n);
+	for (std::size_t k = 0; k < n; k++) {
+		const double t = std::cos(chebyshev::pi * (k + 0.5) / n);
+		result[k] = interval.min / 2 + interval.max / 2 + t * interval.width() / 2;
+	}
+	return result;
+}
+
+Chebyshev polynomial::chebyshev_interpolant(std::span<const double> samples, const Interval& interval)
+{
+	assert(samples.size() > 0);
+	const std::vector<double> transformed = chebyshev::dct_2(samples);
+	const double n = static_cast<double>(samples.size());
+	Chebyshev result(samples.size(), 0.0, interval);
+	result[0] = transformed[0] / n;
+	for (std::size_t j = 1; j < samples.size(); j++) {
+		result[j] = 2.0 * transformed[j] / n;
+	}
+	return result;
+}
+
+double polynomial::evaluate(const Chebyshev& p, double x)
+{
+	const double t = chebyshev::to_unit(p.interval, x);
+	double b_1 = 0.0;	//b_{j+1}
+	double b_2 = 0.0;	//b_{j+2}
+	for (int j = p.degree(); j >= 1; j--) {
+		const double b_0 = p[j] + 2.0 * t * b_1 - b_2;
+		b_2 = b_1;
+		b_1 = b_0;
+	}
+	return p[0] + t * b_1 - b_2;
+}
+
+Bernstein polynomial::to_bernstein(const Chebyshev& p, const Interval& interval, double* largest)
+{
+	//the clenshaw recurrence b_j = c_j + 2t * b_{j+1} - b_{j+2} with polynomials b_j of degree n - j in bernstein base over interval.
+	//t = t_0 * B_0^1 + t_1 * B_1^1 with the values t_0, t_1 of t at the ends of interval.
+	//thus for b of degree m the product t * b has coefficients (k * t_1 * b[k-1] + (m+1-k) * t_0 * b[k]) / (m+1)
+	//and the degree elevation of b has coefficients (k * b[k-1] + (m+1-k) * b[k]) / (m+1)
+	const int n = p.degree();
+	const double t_0 = chebyshev::to_unit(p.interval, interval.min);
+	const double t_1 = chebyshev::to_unit(p.interval, interval.max);
+	const auto combine = [](const Coefficients& b, double lower_factor, double upper_factor) {
+		const std::size_t m = b.size() - 1;
+		Coefficients result(m + 2, 0.0);
+		for (std::size_t k = 0; k <= m + 1; k++) {
+			const double lower = k > 0 ? k * lower_factor * b[k - 1] : 0.0;
+			const double upper = k <= m ? (m + 1 - k) * upper_factor * b[k] : 0.0;
+			result[k] = (lower + upper) / (m + 1);
+		}
+		return result;
+	};
+
+	double biggest = std::abs(p[n]);
+	Coefficients b_2;	//b_{j+2}, empty stands for 0
+	Coefficients b_1 = { p[n] };	//b_{j+1}
+	for (int j = n - 1; j >= 0; j--) {
+		//the final step of clenshaw (j = 0) takes t * b_1 instead of 2t * b_1
+		Coefficients b_0 = combine(b_1, t_1, t_0);
+		const double factor = j > 0 ? 2.0 : 1.0;
+		const Coefficients b_2_elevated = b_2.empty() ? Coefficients() : combine(combine(b_2, 1.0, 1.0), 1.0, 1.0);
+		for (std::size_t k = 0; k < b_0.size(); k++) {
+			b_0[k] = p[j] + factor * b_0[k] - (b_2.empty() ? 0.0 : b_2_elevated[k]);
+			biggest = std::max(biggest, std::abs(b_0[k]));
+		}
+		b_2 = std::move(b_1);
+		b_1 = std::move(b_0);
+	}
+	if (largest) {
+		*largest = biggest;
+	}
+	return Bernstein(std::move(b_1), interval);
+}
+
+std::vector<Interval> descartes_root_isolation(const Chebyshev& p, double min_width)
+{
+	using Isolate = isolation::Engine<isolation::Min_Width, isolation::Midpoint_Split, isolation::Left_To_Right>;
+	constexpr double allowed_growth = 1024.0;
+
+	double coefficient_sum = 0.0;
+	for (const double c : p) {
+		coefficient_sum += std::abs(c);
+	}
+	std::vector<Interval> result;
+	std::vector<Interval> parts = { p.interval };	//stack, upper part below lower part
+	while (!parts.empty()) {
+		const Interval part = parts.back();
+		parts.pop_back();
+		double largest;
+		const Bernstein b = to_bernstein(p, part, &largest);
+		if (largest > allowed_growth * coefficient_sum && part.width() > min_width) {
+			const double middle = part.min / 2 + part.max / 2;
+			parts.push_back(Interval{ middle, part.max });
+			parts.push_back(Interval{ part.min, middle });
+			continue;
+		}
+		const std::vector<Interval> found = Isolate(isolation::Min_Width{ min_width })(b);
+		result.insert(result.end(), found.begin(), found.end());
+	}
+	return result;
+}
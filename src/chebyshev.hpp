@@ -0,0 +1,52 @@
+#pragma once
+
+#include <vector>
+#include <span>
+
+#include "descartes.hpp"
+
+namespace polynomial {
+
+	//\sum_{j=0}^n c_j * T_j(t), where T_j is the j-th chebyshev polynomial of the first kind
+	//and t = (2x - interval.min - interval.max) / interval.width() maps interval to [-1, 1].
+	//well conditioned also for high degrees, where monomial coefficients of the same function are useless.
+	struct Chebyshev
+		:public Coefficients
+	{
+		Interval interval;
+
+		Chebyshev(std::size_t size, double value, Interval interval_) :Coefficients(size, value), interval(interval_) {
+			assert(size > 0);
+		}
+
+		Chebyshev(Coefficients&& coeffs, Interval interval_) :Coefficients(std::move(coeffs)), interval(interval_) {
+			assert(this->size() > 0);
+		}
+
+		int degree() const { return this->size() - 1; }
+	};
+
+	//the n chebyshev points of the first kind in interval, x_k = cos(pi * (k + 1/2) / n) mapped from [-1, 1] (descending)
+	std::vector<double> chebyshev_points(std::size_t n, const Interval& interval);
+
+	//the polynomial of degree samples.size() - 1 interpolating samples[k] at chebyshev_points(samples.size(), interval)[k].
+	//computed with a DCT-II in O(n log n)
+	Chebyshev chebyshev_interpolant(std::span<const double> samples, const Interval& interval);
+
+	//clenshaw recurrence, x is a point of the original interval (not of [-1, 1])
+	double evaluate(const Chebyshev& p, double x);
+
+	//the same polynomial in bernstein base relative to interval (usually a part of p.interval).
+	//runs the clenshaw recurrence directly on bernstein coefficients (multiplying with t and degree elevation
+	//only combine neighbouring coefficients), so no monomial coefficients are ever formed. O(n^2)
+	//the bernstein coefficients of T_n over [-1, 1] grow like 2^n, thus for high degrees interval has to be a small enough part
+	//of p.interval to be accurate. largest receives the largest coefficient of all clenshaw steps, an estimate of the rounding error.
+	Bernstein to_bernstein(const Chebyshev& p, const Interval& interval, double* largest = nullptr);
+
+} //namespace polynomial
+
+//p.interval is halved until to_bernstein is accurate on each part (largest intermediate coefficient at most 1024 times
+//the sum of the absolute chebyshev coefficients), then each part is isolated in bernstein base.
+//intervals narrower than min_width are accepted as final, the result is in ascending order.
+//(a root exactly at the border of two parts is not found, just as a root exactly at a split point of descartes_root_isolation)
+std::vector<Interval> descartes_root_isolation(const polynomial::Chebyshev& p, double min_width = 0.000001);
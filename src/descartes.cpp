@@ -1,10 +1,14 @@
 #include "descartes.hpp"
+#include "isolation_engine.hpp"
+#include "trace.hpp"
+#include "low_degree.hpp"
 
 #include <cmath>
 #include <algorithm>
 #include <numeric>
 #include <cassert>
 #include <cstdio>
+#include <queue>
 
 std::ostream& operator<<(std::ostream& stream, Interval interval)
 {
@@ -195,7 +199,7 @@ namespace polynomial {
 
 	Monomials derive(const Monomials& p)
 	{
-		Monomials derived(p.size() - 1, 0.0);
+		Monomials derived(std::max<std::size_t>(p.size() - 1, 1), 0.0);	//a constant derives to the zero polynomial
 		for (int i = 1; i <= p.degree(); i++) {
 			derived[i - 1] = p[i] * i;
 		}
@@ -253,6 +257,38 @@ namespace polynomial {
 		return result;
 	}
 
+	void to_bernstein(const double* monomials, std::size_t size, const Interval& interval, double* bernstein)
+	{
+		assert(size > 0);
+		const std::size_t n = size - 1;
+		double* const c = bernstein;
+		std::copy(monomials, monomials + size, c);
+
+		//c becomes p(min + x)
+		for (std::size_t i = 0; i < n; i++) {
+			for (std::size_t j = n - 1; j + 1 > i; j--) {
+				c[j] += interval.min * c[j + 1];
+			}
+		}
+		//c becomes p(min + width * x), so [0, 1] is mapped to interval
+		double width_power = 1.0;
+		for (std::size_t i = 1; i <= n; i++) {
+			width_power *= interval.width();
+			c[i] *= width_power;
+		}
+		//monomials to bernstein on [0, 1]: b_k = \sum_{i=0}^k chose(k, i) / chose(n, i) * c_i
+		double n_chose_i = 1.0;
+		for (std::size_t i = 1; i <= n; i++) {
+			n_chose_i = n_chose_i * (n - i + 1) / i;
+			c[i] /= n_chose_i;
+		}
+		for (std::size_t j = 1; j <= n; j++) {	//pascals triangle, applied to the coefficients
+			for (std::size_t k = n; k >= j; k--) {
+				c[k] += c[k - 1];
+			}
+		}
+	}
+
 	double evaluate(const Bernstein& polynomial, double x)
 	{
 		const double a = polynomial.interval.min;
@@ -316,7 +352,7 @@ std::vector<double> binomial_coefficients(std::size_t n_size)
 	return coefficients;
 }
 
-double absolute_biggest_coefficient(const std::vector<double>& vec)
+double absolute_biggest_coefficient(std::span<const double> vec)
 {
 	if (vec.size()) {
 		const auto [min, max] = std::minmax_element(vec.begin(), vec.end());
@@ -339,7 +375,7 @@ Monomials line_pow(Line line, std::size_t n)
 	return result;
 }
 
-std::size_t number_sign_changes(const std::vector<double> & p)
+std::size_t number_sign_changes(std::span<const double> p)
 {
 	std::size_t sign_changes = 0;
 	enum class Sign
@@ -372,7 +408,7 @@ std::size_t number_sign_changes(const std::vector<double> & p)
 	return sign_changes;
 }
 
-std::vector<double> to_unnormalized_bernstein(const Monomials& p, Interval relative_to)
+Coefficients to_unnormalized_bernstein(const Monomials& p, Interval relative_to)
 {
 	Monomials result(p.size(), 0.0);
 	for (int i = 0; i <= p.degree(); i++) {
@@ -386,9 +422,64 @@ std::vector<double> to_unnormalized_bernstein(const Monomials& p, Interval relat
 	return result;
 }
 
+Bernstein_Plan::Bernstein_Plan(std::size_t degree, const Interval& interval_, bool normalized)
+	:size(degree + 1), interval(interval_), transposed_matrix(this->size * this->size, 0.0)
+{
+	const std::vector<double> binomials = binomial_coefficients(degree);
+
+	//monomial coefficient i contributes (x+1)^{n-i} * (ax+b)^i, same as in to_unnormalized_bernstein
+	for (std::size_t i = 0; i < this->size; i++) {
+		const Monomials column = line_pow(Line{ 1, 1 }, degree - i) * line_pow(Line{ interval_.min, interval_.max }, i);
+		for (std::size_t k = 0; k < this->size; k++) {
+			this->transposed_matrix[i * this->size + k] = normalized ? column[k] / binomials[k] : column[k];
+		}
+	}
+}
+
+Bernstein Bernstein_Plan::execute(const Monomials& p) const
+{
+	assert(p.size() == this->size);
+	Bernstein result(this->size, 0.0, this->interval);
+	this->execute_batch(p.data(), result.data(), 1);
+	return result;
+}
+
+void Bernstein_Plan::execute_batch(const double* monomials, double* bernstein, std::size_t count) const
+{
+	//block sizes chosen, so that a block of the matrix and the current rows of in- and output stay in L1 / L2
+	constexpr std::size_t row_block = 64;
+	constexpr std::size_t inner_block = 64;
+	constexpr std::size_t column_block = 256;
+	const std::size_t m = this->size;
+
+	std::fill(bernstein, bernstein + count * m, 0.0);
+
+	for (std::size_t k0 = 0; k0 < m; k0 += column_block) {
+		const std::size_t k_end = std::min(k0 + column_block, m);
+		for (std::size_t i0 = 0; i0 < m; i0 += inner_block) {
+			const std::size_t i_end = std::min(i0 + inner_block, m);
+			for (std::size_t r0 = 0; r0 < count; r0 += row_block) {
+				const std::size_t r_end = std::min(r0 + row_block, count);
+
+				for (std::size_t r = r0; r < r_end; r++) {
+					const double* const in_row = monomials + r * m;
+					double* const out_row = bernstein + r * m;
+					for (std::size_t i = i0; i < i_end; i++) {
+						const double factor = in_row[i];
+						const double* const matrix_row = this->transposed_matrix.data() + i * m;
+						for (std::size_t k = k0; k < k_end; k++) {	//contiguous in output and matrix, vectorizes
+							out_row[k] += factor * matrix_row[k];
+						}
+					}
+				}
+			}
+		}
+	}
+}
+
 std::size_t upper_bound_roots(const Monomials& p, Interval search_area)
 {
-	const std::vector<double> unnormalized_bernstein_coeffs = to_unnormalized_bernstein(p, search_area);
+	const Coefficients unnormalized_bernstein_coeffs = to_unnormalized_bernstein(p, search_area);
 
 	const auto roots_at_0 = std::distance(unnormalized_bernstein_coeffs.begin(), 
 		std::find_if(unnormalized_bernstein_coeffs.begin(), unnormalized_bernstein_coeffs.end(), nonzero));
@@ -397,86 +488,620 @@ std::size_t upper_bound_roots(const Monomials& p, Interval search_area)
 }
 
 std::vector<Interval> descartes_root_isolation(const Monomials& p, const Interval& start_zone, 
-	bool(*accept)(const Monomials& p, const Interval& i))
+	bool(*accept)(const Monomials& p, const Interval& i), Subdivision_Trace* trace)
 {
-	std::vector<Interval> root_intervals;
-	root_intervals.reserve(p.degree());
+	using namespace isolation;
+	if (trace) {	//closed forms are skipped, as there would be no tree to trace
+		return Engine<Accept_Function, Midpoint_Split, Depth_First, Tracing_Statistics>(
+			Accept_Function{ accept }, Midpoint_Split{}, Tracing_Statistics{ trace })(p, start_zone);
+	}
+	if (p.degree() <= low_degree::max_degree && accept == default_accept) {	//the closed forms never accept a cluster
+		if (auto roots = low_degree::certified_roots(p, start_zone)) {
+			return std::move(*roots);
+		}
+	}
+	return Engine<Accept_Function>(Accept_Function{ accept })(p, start_zone);
+}
 
-	std::vector<Interval> search_intervals;		//called Q in VikramSharma
-	search_intervals.reserve(p.degree());
-	search_intervals.push_back(start_zone);
+namespace frontier {
 
-	while (search_intervals.size()) {
-		const auto current = search_intervals.back();
-		search_intervals.pop_back();
+	//appends the leaves of the subdivision of zone to leaves, sorted left to right
+	void subdivide(const Monomials& p, const Interval& zone,
+		bool(*accept)(const Monomials& p, const Interval& i), Isolation_Frontier& leaves)
+	{
+		std::vector<Interval> search_intervals;
+		search_intervals.push_back(zone);
 
-		const auto roots_in_interval = upper_bound_roots(p, current);
-		if (roots_in_interval == 0) {
-			continue;	//throw away current
+		while (search_intervals.size()) {
+			const auto current = search_intervals.back();
+			search_intervals.pop_back();
+
+			const auto roots_in_interval = upper_bound_roots(p, current);
+			if (roots_in_interval <= 1 || accept(p, current)) {
+				leaves.push_back(Frontier_Leaf{ current, roots_in_interval });
+			}
+			else {	//split current, right half is pushed first to be processed last
+				const double midpoint = (current.min / 2) + (current.max / 2);
+				search_intervals.emplace_back(Interval{ midpoint, current.max });
+				search_intervals.emplace_back(Interval{ current.min, midpoint });
+			}
 		}
-		else if (roots_in_interval == 1 || accept(p, current)) {
-			root_intervals.push_back(current);	//accepted as final interval
+	}
+
+	//merges neighbouring leaves without roots, if their union has no roots either.
+	//only pairs where at least one leaf is marked as changed are tested.
+	Isolation_Frontier merge_empty(const Monomials& p, const Isolation_Frontier& leaves, const std::vector<bool>& changed)
+	{
+		Isolation_Frontier result;
+		result.reserve(leaves.size());
+		bool last_changed = false;
+
+		for (std::size_t i = 0; i < leaves.size(); i++) {
+			const Frontier_Leaf& leaf = leaves[i];
+			if (result.size() && result.back().roots == 0 && leaf.roots == 0 && (last_changed || changed[i])) {
+				const Interval joined = { result.back().interval.min, leaf.interval.max };
+				if (upper_bound_roots(p, joined) == 0) {
+					result.back().interval = joined;
+					last_changed = true;
+					continue;
+				}
+			}
+			result.push_back(leaf);
+			last_changed = changed[i];
 		}
-		else if (roots_in_interval > 1) {	//split current
-			const double midpoint = (current.min / 2) + (current.max / 2);
-			search_intervals.emplace_back(Interval{ current.min, midpoint });
-			search_intervals.emplace_back(Interval{ midpoint, current.max });
+		return result;
+	}
+
+} //namespace frontier
+
+namespace single_root {
+
+	//i = [a, b) contains exactly one root of p, the returned part of i still contains it.
+	//as there is only one root, comparing signs tells on which side of the point cut it lies.
+	Interval cut(const Monomials& p, const Interval& i, double cut)
+	{
+		const double value_at_cut = evaluate(p, cut);
+		const double value_at_min = evaluate(p, i.min);
+		if (value_at_cut == 0.0) {
+			return Interval{ cut, cut };
+		}
+		else if (value_at_min == 0.0) {
+			return Interval{ i.min, i.min };
+		}
+		else if ((value_at_min < 0.0) != (value_at_cut < 0.0)) {
+			return Interval{ i.min, cut };
+		}
+		else {
+			return Interval{ cut, i.max };
 		}
 	}
-	return root_intervals;
+
+} //namespace single_root
+
+Isolation_Frontier descartes_frontier(const Monomials& p, const Interval& start_zone,
+	bool(*accept)(const Monomials& p, const Interval& i))
+{
+	Isolation_Frontier leaves;
+	frontier::subdivide(p, start_zone, accept, leaves);
+	return frontier::merge_empty(p, leaves, std::vector<bool>(leaves.size(), true));
+}
+
+Isolation_Frontier repair_frontier(const Monomials& p, const Isolation_Frontier& previous,
+	bool(*accept)(const Monomials& p, const Interval& i))
+{
+	Isolation_Frontier leaves;
+	leaves.reserve(previous.size());
+	std::vector<bool> changed;
+	changed.reserve(previous.size());
+
+	for (const auto& leaf : previous) {
+		const auto roots_in_interval = upper_bound_roots(p, leaf.interval);
+		if (roots_in_interval <= 1 || accept(p, leaf.interval)) {
+			leaves.push_back(Frontier_Leaf{ leaf.interval, roots_in_interval });
+			changed.push_back(roots_in_interval != leaf.roots);
+		}
+		else {
+			frontier::subdivide(p, leaf.interval, accept, leaves);
+			changed.resize(leaves.size(), true);
+		}
+	}
+	return frontier::merge_empty(p, leaves, changed);
+}
+
+std::vector<Interval> root_intervals(const Isolation_Frontier& frontier)
+{
+	std::vector<Interval> result;
+	for (const auto& leaf : frontier) {
+		if (leaf.roots > 0) {
+			result.push_back(leaf.interval);
+		}
+	}
+	return result;
+}
+
+Root_Index::Root_Index(const Monomials& polinomial_, const Interval& start_zone,
+	bool(*accept)(const Monomials& p, const Interval& i))
+	:polinomial(polinomial_)
+{
+	for (const auto& leaf : descartes_frontier(polinomial_, start_zone, accept)) {
+		if (leaf.roots > 0) {
+			this->leaves.push_back(leaf);
+		}
+	}
+	this->roots_before.reserve(this->leaves.size() + 1);
+	this->roots_before.push_back(0);
+	for (const auto& leaf : this->leaves) {
+		this->roots_before.push_back(this->roots_before.back() + leaf.roots);
+	}
+}
+
+std::size_t Root_Index::first_not_before(double x) const
+{
+	//a leaf [a, b) holds its root r with a <= r < b, so it lies before x if b <= x, except it is the single point [x, x]
+	const auto before = [](const Frontier_Leaf& leaf, double x) {
+		return leaf.interval.max < x || (leaf.interval.max == x && leaf.interval.min < leaf.interval.max);
+	};
+	return std::distance(this->leaves.begin(), std::lower_bound(this->leaves.begin(), this->leaves.end(), x, before));
+}
+
+void Root_Index::cut_at(double x)
+{
+	const std::size_t index = this->first_not_before(x);
+	if (index == this->leaves.size()) {
+		return;
+	}
+	Frontier_Leaf& leaf = this->leaves[index];
+	if (leaf.roots != 1) {
+		return;	//empty or cluster, can not be refined
+	}
+
+	while (leaf.interval.min < x && x < leaf.interval.max) {
+		const double midpoint = (leaf.interval.min / 2) + (leaf.interval.max / 2);
+		const bool midpoint_inside = leaf.interval.min < midpoint && midpoint < leaf.interval.max;
+		leaf.interval = single_root::cut(this->polinomial, leaf.interval, midpoint_inside ? midpoint : x);
+	}
+	//a root exactly at x is made the single point [x, x], so leaves_in can tell it apart from a root right of x
+	if (leaf.interval.min == x && x < leaf.interval.max && evaluate(this->polinomial, x) == 0.0) {
+		leaf.interval = Interval{ x, x };
+	}
+}
+
+std::pair<std::size_t, std::size_t> Root_Index::leaves_in(const Interval& range)
+{
+	this->cut_at(range.min);
+	this->cut_at(range.max);
+
+	//mirrors first_not_before: a leaf [x, b) lies after x, except it is the single point [x, x]
+	const auto after = [](double x, const Frontier_Leaf& leaf) {
+		return x < leaf.interval.min || (x == leaf.interval.min && leaf.interval.min < leaf.interval.max);
+	};
+	const std::size_t first = this->first_not_before(range.min);
+	const std::size_t last = std::distance(this->leaves.begin(), 
+		std::upper_bound(this->leaves.begin() + first, this->leaves.end(), range.max, after));
+	return std::make_pair(first, last);
+}
+
+std::size_t Root_Index::count_roots(const Interval& range)
+{
+	const auto [first, last] = this->leaves_in(range);
+	return this->roots_before[last] - this->roots_before[first];
+}
+
+std::vector<Interval> Root_Index::roots_in(const Interval& range)
+{
+	const auto [first, last] = this->leaves_in(range);
+	std::vector<Interval> result;
+	result.reserve(last - first);
+	for (std::size_t i = first; i < last; i++) {
+		result.push_back(this->leaves[i].interval);
+	}
+	return result;
 }
 
 std::pair<polynomial::Bernstein, polynomial::Bernstein> de_casteljau_split(const polynomial::Bernstein& b)
 {
+	return de_casteljau_split(b, 0.5);
+}
+
+std::pair<polynomial::Bernstein, polynomial::Bernstein> de_casteljau_split(const polynomial::Bernstein& b, double t)
+{
+	assert(t > 0.0 && t < 1.0);
 	const int n = b.degree();
-	std::vector<std::vector<double>> coeffs(n + 1, std::vector<double>(n + 1, 0.0));
-	coeffs[0] = b;
+	const double m = t == 0.5 ? b.interval.min / 2 + b.interval.max / 2 : b.interval.min + t * b.interval.width();
+	const double s = 1.0 - t;
+	polynomial::Bernstein fst_half(n + 1, 0.0, Interval{ b.interval.min, m });
+	polynomial::Bernstein snd_half(n + 1, 0.0, Interval{ m, b.interval.max });
 
+	//the rows of de casteljaus triangle are computed in place, row i yields fst_half[i] and snd_half[n - i]
+	polynomial::Coefficients row = b;
+	fst_half[0] = row[0];
+	snd_half[n] = row[n];
 	for (int i = 1; i <= n; i++) {
 		for (int j = 0; j <= n - i; j++) {
-			coeffs[i][j] = 0.5 * coeffs[i - 1][j] + 0.5 * coeffs[i - 1][j + 1];
+			row[j] = s * row[j] + t * row[j + 1];
 		}
-	}
-	
-	const double m = b.interval.min / 2 + b.interval.max / 2;
-	polynomial::Bernstein fst_half(n + 1, 0.0, Interval{ b.interval.min, m });
-	polynomial::Bernstein snd_half(n + 1, 0.0, Interval{ m, b.interval.max });
-	for (int i = 0; i <= n; i++) {
-		fst_half[i] = coeffs[i][0];
-		snd_half[i] = coeffs[n - i][i];
+		fst_half[i] = row[0];
+		snd_half[n - i] = row[n - i];
 	}
 
 	return std::make_pair(std::move(fst_half), std::move(snd_half));
 }
 
 
-std::vector<Interval> descartes_root_isolation(const polynomial::Bernstein& b)
+std::vector<Interval> descartes_root_isolation(const polynomial::Bernstein& b, Subdivision_Trace* trace)
+{
+	using namespace isolation;
+	if (trace) {
+		return Engine<Min_Width, Midpoint_Split, Depth_First, Tracing_Statistics>(
+			Min_Width{ 0.000001 }, Midpoint_Split{}, Tracing_Statistics{ trace })(b);
+	}
+	return Engine<Min_Width>(Min_Width{ 0.000001 })(b);
+}
+
+std::vector<Monomials> derivative_family(const Monomials& p, std::size_t count)
+{
+	std::vector<Monomials> family;
+	family.reserve(count);
+	for (std::size_t i = 0; i < count; i++) {
+		family.push_back(i == 0 ? p : derive(family.back()));
+	}
+	return family;
+}
+
+namespace family {
+
+	//node of the shared subdivision tree.
+	//block holds the bernstein coefficients of all members still active in the node interleaved:
+	//coefficient k of the j-th active member is at block[k * members.size() + j]
+	struct Node
+	{
+		Interval interval;
+		std::vector<std::size_t> members;	//indices into the family
+		std::vector<double> block;
+	};
+
+	//same as number_sign_changes, but for the coefficients block[offset], block[offset + stride], ...
+	std::size_t sign_changes(const std::vector<double>& block, std::size_t offset, std::size_t stride)
+	{
+		std::size_t changes = 0;
+		double last = 0.0;
+		for (std::size_t i = offset; i < block.size(); i += stride) {
+			if (block[i] != 0.0) {
+				changes += (last < 0.0 && block[i] > 0.0) || (last > 0.0 && block[i] < 0.0);
+				last = block[i];
+			}
+		}
+		return changes;
+	}
+
+	//de_casteljau_split of all members at once, each step of the triangle works on whole rows of the block
+	std::pair<Node, Node> split(Node&& node)
+	{
+		const std::size_t width = node.members.size();
+		const std::size_t n = node.block.size() / width - 1;
+		const double midpoint = node.interval.min / 2 + node.interval.max / 2;
+
+		Node lower = { Interval{ node.interval.min, midpoint }, node.members, std::vector<double>(node.block.size()) };
+		Node upper = { Interval{ midpoint, node.interval.max }, std::move(node.members), std::vector<double>(node.block.size()) };
+		std::vector<double>& triangle = node.block;	//overwritten in place, one row after another
+
+		std::copy_n(triangle.begin(), width, lower.block.begin());
+		std::copy_n(triangle.begin() + n * width, width, upper.block.begin() + n * width);
+		for (std::size_t i = 1; i <= n; i++) {
+			for (std::size_t j = 0; j < (n - i + 1) * width; j++) {
+				triangle[j] = 0.5 * triangle[j] + 0.5 * triangle[j + width];
+			}
+			std::copy_n(triangle.begin(), width, lower.block.begin() + i * width);
+			std::copy_n(triangle.begin() + (n - i) * width, width, upper.block.begin() + (n - i) * width);
+		}
+		return std::make_pair(std::move(lower), std::move(upper));
+	}
+
+	//keeps only the members at the given positions
+	void retain(Node& node, const std::vector<std::size_t>& positions)
+	{
+		const std::size_t width = node.members.size();
+		const std::size_t size = node.block.size() / width;
+		std::vector<std::size_t> members;
+		std::vector<double> block;
+		members.reserve(positions.size());
+		block.reserve(size * positions.size());
+		for (const std::size_t position : positions) {
+			members.push_back(node.members[position]);
+		}
+		for (std::size_t k = 0; k < size; k++) {
+			for (const std::size_t position : positions) {
+				block.push_back(node.block[k * width + position]);
+			}
+		}
+		node.members = std::move(members);
+		node.block = std::move(block);
+	}
+
+} //namespace family
+
+std::vector<std::vector<Interval>> family_root_isolation(const std::vector<Monomials>& members, const Interval& start_zone, double min_width)
 {
-	std::vector<Interval> root_intervals;
-	root_intervals.reserve(b.degree());
+	std::vector<std::vector<Interval>> root_intervals(members.size());
+	if (members.empty()) {
+		return root_intervals;
+	}
+
+	//members of lower degree are padded with zeros, which is the same polynomial in a bernstein base of higher degree
+	std::size_t size = 0;
+	for (const auto& member : members) {
+		size = std::max(size, member.size());
+	}
+	family::Node start = { start_zone, std::vector<std::size_t>(members.size()), std::vector<double>(size * members.size()) };
+	for (std::size_t j = 0; j < members.size(); j++) {
+		Monomials padded(size, 0.0);
+		std::copy(members[j].begin(), members[j].end(), padded.begin());
+		const Bernstein b = to_bernstein(padded, start_zone);
+		start.members[j] = j;
+		for (std::size_t k = 0; k < size; k++) {
+			start.block[k * members.size() + j] = b[k];
+		}
+	}
 
-	std::vector<polynomial::Bernstein> search_objects;
-	search_objects.reserve(b.degree());
-	search_objects.push_back(b);
+	std::vector<family::Node> search_nodes;
+	search_nodes.push_back(std::move(start));
+	std::vector<std::size_t> unresolved;
 
-	while (search_objects.size()) {
-		const auto current = std::move(search_objects.back());
-		search_objects.pop_back();
+	while (search_nodes.size()) {
+		family::Node current = std::move(search_nodes.back());
+		search_nodes.pop_back();
+
+		unresolved.clear();
+		for (std::size_t j = 0; j < current.members.size(); j++) {
+			const std::size_t sign_variations = family::sign_changes(current.block, j, current.members.size());
+			if (sign_variations == 1 || (sign_variations > 1 && current.interval.width() < min_width)) {
+				root_intervals[current.members[j]].push_back(current.interval);
+			}
+			else if (sign_variations > 1) {
+				unresolved.push_back(j);
+			}
+		}
+		if (unresolved.empty()) {
+			continue;
+		}
+		if (unresolved.size() < current.members.size()) {
+			family::retain(current, unresolved);
+		}
+		//same order as descartes_root_isolation for polynomial::Bernstein
+		auto [lower, upper] = family::split(std::move(current));
+		search_nodes.push_back(std::move(lower));
+		search_nodes.push_back(std::move(upper));
+	}
+	return root_intervals;
+}
+
+namespace level_set {
+
+	struct Node
+	{
+		Bernstein polynomial;
+		std::vector<std::size_t> levels;	//indices of the levels still active in the node, ascending
+	};
+
+	//same as number_sign_changes for the coefficients of p - level
+	std::size_t sign_changes(const Bernstein& p, double level)
+	{
+		std::size_t changes = 0;
+		double last = 0.0;
+		for (const double coefficient : p) {
+			const double shifted = coefficient - level;
+			if (shifted != 0.0) {
+				changes += (last < 0.0 && shifted > 0.0) || (last > 0.0 && shifted < 0.0);
+				last = shifted;
+			}
+		}
+		return changes;
+	}
+
+} //namespace level_set
+
+std::vector<std::vector<Interval>> level_set_isolation(const Bernstein& polynomial, const std::vector<double>& levels, double min_width)
+{
+	assert(std::is_sorted(levels.begin(), levels.end()));
+	std::vector<std::vector<Interval>> root_intervals(levels.size());
+
+	std::vector<level_set::Node> search_nodes;
+	search_nodes.push_back(level_set::Node{ polynomial, std::vector<std::size_t>(levels.size()) });
+	std::iota(search_nodes.back().levels.begin(), search_nodes.back().levels.end(), 0);
+	std::vector<std::size_t> unresolved;
+
+	while (search_nodes.size()) {
+		level_set::Node current = std::move(search_nodes.back());
+		search_nodes.pop_back();
+		const Interval& interval = current.polynomial.interval;
+
+		//only levels inside the range of the coefficients can have solutions in this node
+		const auto [lowest, highest] = std::minmax_element(current.polynomial.begin(), current.polynomial.end());
+		const auto first = std::lower_bound(current.levels.begin(), current.levels.end(), *lowest,
+			[&levels](std::size_t index, double value) { return levels[index] < value; });
+		const auto last = std::upper_bound(first, current.levels.end(), *highest,
+			[&levels](double value, std::size_t index) { return value < levels[index]; });
+
+		unresolved.clear();
+		for (auto level = first; level != last; ++level) {
+			const std::size_t sign_variations = level_set::sign_changes(current.polynomial, levels[*level]);
+			if (sign_variations == 1 || (sign_variations > 1 && interval.width() < min_width)) {
+				root_intervals[*level].push_back(interval);
+			}
+			else if (sign_variations > 1) {
+				unresolved.push_back(*level);
+			}
+		}
+		if (unresolved.empty()) {
+			continue;
+		}
+		//same order as descartes_root_isolation for polynomial::Bernstein
+		auto [lower, upper] = de_casteljau_split(current.polynomial);
+		search_nodes.push_back(level_set::Node{ std::move(lower), unresolved });
+		search_nodes.push_back(level_set::Node{ std::move(upper), unresolved });
+	}
+	return root_intervals;
+}
+
+std::vector<std::vector<Interval>> level_set_isolation(const Monomials& polinomial, const Interval& start_zone,
+	const std::vector<double>& levels, double min_width)
+{
+	return level_set_isolation(to_bernstein(polinomial, start_zone), levels, min_width);
+}
+
+namespace targeted {
+
+	//bounds of the distance measure for any root inside an interval
+	struct Key_Bounds
+	{
+		double lower, upper;
+	};
+
+	struct Node
+	{
+		Interval interval;
+		Key_Bounds key;
+		bool certified;	//interval holds exactly one root (or a cluster accepted by accept)
+		bool refinable;	//false for accepted clusters
+	};
+
+	//best first search: nodes are processed by the lower bound of their key, subtrees which can not contain
+	//one of the k best roots are never touched. a certified interval is returned, once no other node can 
+	//contain a better root, else it is refined by bisection until that is the case.
+	template<typename Key>
+	std::vector<Interval> best_roots(const Monomials& p, const Interval& start_zone, std::size_t k, Key key,
+		bool(*accept)(const Monomials& p, const Interval& i))
+	{
+		const auto worse = [](const Node& a, const Node& b) { return a.key.lower > b.key.lower; };
+		std::priority_queue<Node, std::vector<Node>, decltype(worse)> queue(worse);
+		queue.push(Node{ start_zone, key(start_zone), false, false });
+
+		std::vector<Interval> result;
+		while (queue.size() && result.size() < k) {
+			const Node current = queue.top();
+			queue.pop();
+
+			if (current.certified) {
+				const double midpoint = (current.interval.min / 2) + (current.interval.max / 2);
+				const bool splittable = current.interval.min < midpoint && midpoint < current.interval.max;
+				if (queue.empty() || current.key.upper <= queue.top().key.lower || !current.refinable || !splittable) {
+					result.push_back(current.interval);
+				}
+				else {
+					const Interval refined = single_root::cut(p, current.interval, midpoint);
+					queue.push(Node{ refined, key(refined), true, true });
+				}
+				continue;
+			}
+
+			const auto roots_in_interval = upper_bound_roots(p, current.interval);
+			if (roots_in_interval == 0) {
+				continue;
+			}
+			else if (roots_in_interval == 1 || accept(p, current.interval)) {
+				queue.push(Node{ current.interval, current.key, true, roots_in_interval == 1 });
+			}
+			else {
+				const double midpoint = (current.interval.min / 2) + (current.interval.max / 2);
+				const Interval lower = { current.interval.min, midpoint };
+				const Interval upper = { midpoint, current.interval.max };
+				queue.push(Node{ lower, key(lower), false, false });
+				queue.push(Node{ upper, key(upper), false, false });
+			}
+		}
+		return result;
+	}
+
+} //namespace targeted
+
+std::vector<Interval> smallest_roots(const Monomials& p, const Interval& start_zone, std::size_t k,
+	bool(*accept)(const Monomials& p, const Interval& i))
+{
+	const auto position = [](const Interval& i) { return targeted::Key_Bounds{ i.min, i.max }; };
+	return targeted::best_roots(p, start_zone, k, position, accept);
+}
+
+std::vector<Interval> roots_above(const Monomials& p, const Interval& start_zone, double threshold, std::size_t k,
+	bool(*accept)(const Monomials& p, const Interval& i))
+{
+	if (threshold >= start_zone.max) {
+		return {};
+	}
+	return smallest_roots(p, Interval{ std::max(threshold, start_zone.min), start_zone.max }, k, accept);
+}
+
+std::vector<Interval> nearest_roots(const Monomials& p, const Interval& start_zone, double target, std::size_t k,
+	bool(*accept)(const Monomials& p, const Interval& i))
+{
+	const auto distance = [target](const Interval& i) {
+		return targeted::Key_Bounds{
+			std::max({ 0.0, i.min - target, target - i.max }),
+			std::max(std::abs(target - i.min), std::abs(target - i.max))
+		};
+	};
+	return targeted::best_roots(p, start_zone, k, distance, accept);
+}
+
+Root_Stream::Root_Stream(const Monomials& polinomial_, const Interval& start_zone, Root_Order order_,
+	bool(*accept_)(const Monomials& p, const Interval& i))
+	:polinomial(polinomial_), accept(accept_), order(order_)
+{
+	this->search_intervals.reserve(polinomial_.degree());
+	this->search_intervals.push_back(start_zone);
+}
+
+std::optional<Interval> Root_Stream::next()
+{
+	while (this->search_intervals.size()) {
+		const auto current = this->search_intervals.back();
+		this->search_intervals.pop_back();
+
+		const auto roots_in_interval = upper_bound_roots(this->polinomial, current);
+		if (roots_in_interval == 0) {
+			continue;	//throw away current
+		}
+		else if (roots_in_interval == 1 || this->accept(this->polinomial, current)) {
+			return current;	//accepted as final interval
+		}
+		else {	//split current, the half pushed last is processed first
+			const double midpoint = (current.min / 2) + (current.max / 2);
+			const Interval lower = { current.min, midpoint };
+			const Interval upper = { midpoint, current.max };
+			this->search_intervals.push_back(this->order == Root_Order::left_to_right ? upper : lower);
+			this->search_intervals.push_back(this->order == Root_Order::left_to_right ? lower : upper);
+		}
+	}
+	return std::nullopt;
+}
+
+Bernstein_Root_Stream::Bernstein_Root_Stream(const polynomial::Bernstein& b, Root_Order order_)
+	:order(order_)
+{
+	this->search_objects.reserve(b.degree());
+	this->search_objects.push_back(b);
+}
+
+std::optional<Interval> Bernstein_Root_Stream::next()
+{
+	while (this->search_objects.size()) {
+		const auto current = std::move(this->search_objects.back());
+		this->search_objects.pop_back();
 
 		const auto sign_variations = number_sign_changes(current);
 		if (sign_variations == 0) {
 			continue;
 		}
 		else if (sign_variations == 1 || current.interval.width() < 0.000001) {
-			root_intervals.push_back(current.interval);
+			return current.interval;
 		}
-		else if (sign_variations > 1) {
+		else {
 			auto [b1, b2] = de_casteljau_split(current);
-			search_objects.push_back(std::move(b1));
-			search_objects.push_back(std::move(b2));
+			const bool lower_first = this->order == Root_Order::left_to_right;
+			this->search_objects.push_back(std::move(lower_first ? b2 : b1));
+			this->search_objects.push_back(std::move(lower_first ? b1 : b2));
 		}
 	}
-	return root_intervals;
+	return std::nullopt;
 }
 
 bool default_accept(const polynomial::Monomials& p, const Interval& i)
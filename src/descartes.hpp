@@ -5,6 +5,10 @@
 #include <iostream>
 #include <cassert>
 #include <complex>
+#include <optional>
+#include <span>
+
+#include "small_vector.hpp"
 
 
 struct Interval
@@ -16,21 +20,30 @@ struct Interval
 
 std::ostream& operator<<(std::ostream& stream, Interval interval);
 
+class Subdivision_Trace;	//see trace.hpp
+
 
 namespace polynomial {
 
+	//storage of all polynomial types: up to degree 15 the coefficients live inside the object, no allocation is needed
+	using Coefficients = Small_Vector<double, 16>;
+
 	struct Monomials 
-		:public  std::vector<double>
+		:public  Coefficients
 	{
-		Monomials(std::initializer_list<double> coeffs) :std::vector<double>(coeffs) {
+		Monomials(std::initializer_list<double> coeffs) :Coefficients(coeffs) {
 			assert(coeffs.size() > 0);
 		}
 
-		Monomials(std::size_t size, double value) :std::vector<double>(size, value) {
+		Monomials(std::size_t size, double value) :Coefficients(size, value) {
 			assert(size > 0);
 		}
 
-		Monomials(std::vector<double>&& coeffs) :std::vector<double>(std::move(coeffs)) {
+		Monomials(std::vector<double>&& coeffs) :Coefficients(coeffs.begin(), coeffs.end()) {
+			assert(this->size() > 0);
+		}
+
+		Monomials(Coefficients&& coeffs) :Coefficients(std::move(coeffs)) {
 			assert(this->size() > 0);
 		}
 
@@ -69,6 +82,7 @@ namespace polynomial {
 
 	double evaluate(const Monomials& polinomial, double x);
 
+	//the derivative of a constant is the zero polynomial { 0.0 }
 	Monomials derive(const Monomials& p);
 
 	Monomials greatest_common_denominator(const Monomials& p1, const Monomials& p2, double allowed_err = 0.001);
@@ -78,19 +92,23 @@ namespace polynomial {
 
 
 	struct Bernstein 
-		:public  std::vector<double>
+		:public  Coefficients
 	{
 		Interval interval;
 
-		Bernstein(std::initializer_list<double> coeffs, Interval interval_) :std::vector<double>(coeffs), interval(interval_) {
+		Bernstein(std::initializer_list<double> coeffs, Interval interval_) :Coefficients(coeffs), interval(interval_) {
 			assert(coeffs.size() > 0);
 		}
 
-		Bernstein(std::size_t size, double value, Interval interval_) :std::vector<double>(size, value), interval(interval_) {
+		Bernstein(std::size_t size, double value, Interval interval_) :Coefficients(size, value), interval(interval_) {
 			assert(size > 0);
 		}
 
-		Bernstein(std::vector<double>&& coeffs, Interval interval_) :std::vector<double>(std::move(coeffs)), interval(interval_) {
+		Bernstein(std::vector<double>&& coeffs, Interval interval_) :Coefficients(coeffs.begin(), coeffs.end()), interval(interval_) {
+			assert(this->size() > 0);
+		}
+
+		Bernstein(Coefficients&& coeffs, Interval interval_) :Coefficients(std::move(coeffs)), interval(interval_) {
 			assert(this->size() > 0);
 		}
 
@@ -104,6 +122,10 @@ namespace polynomial {
 
 	Bernstein to_bernstein(const Monomials& monomials, const Interval& interval);
 
+	//same as to_bernstein (up to rounding), but works on size coefficients in caller owned memory and allocates nothing.
+	//(monomials and bernstein may be the same buffer)
+	void to_bernstein(const double* monomials, std::size_t size, const Interval& interval, double* bernstein);
+
 	double evaluate(const Bernstein& polinomial, double x);
 
 	Bernstein& operator+=(Bernstein& p1, const Bernstein& p2);
@@ -117,14 +139,39 @@ namespace polynomial {
 std::vector<double> binomial_coefficients(std::size_t n_size);
 
 //returns 0.0 if there are no elements
-double absolute_biggest_coefficient(const std::vector<double>& vec);
+double absolute_biggest_coefficient(std::span<const double> vec);
 
 //input l(x) = a*x+b and power n return p(x) = (a*x+b)^n
 polynomial::Monomials line_pow(polynomial::Line line, std::size_t n);
 
+//number of sign changes in the coefficients, zeros are skipped
+std::size_t number_sign_changes(std::span<const double> p);
+
 //returns coefficients of polynomial B in Vikram Sharma
 //result[i] is bernstein[i], but multiplied by binomial::choose(result.size(), i)
-std::vector<double> to_unnormalized_bernstein(const polynomial::Monomials& p, Interval relative_to);
+polynomial::Coefficients to_unnormalized_bernstein(const polynomial::Monomials& p, Interval relative_to);
+
+//base transformation of to_bernstein (or to_unnormalized_bernstein) for a fixed degree and interval.
+//the transformation is a fixed (n+1)x(n+1) matrix, which is build once here and reused for every polynomial.
+class Bernstein_Plan
+{
+private:
+	std::size_t size;	//degree + 1
+	Interval interval;
+	std::vector<double> transposed_matrix;	//row i holds the contributions of monomial coefficient i to all bernstein coefficients
+
+public:
+	Bernstein_Plan(std::size_t degree, const Interval& interval_, bool normalized = true);
+
+	int degree() const { return this->size - 1; }
+	const Interval& get_interval() const { return this->interval; }
+
+	polynomial::Bernstein execute(const polynomial::Monomials& p) const;
+
+	//converts count polynomials at once as cache blocked matrix-matrix product.
+	//every polynomial occupies degree + 1 consecutive doubles, both in monomials and in bernstein.
+	void execute_batch(const double* monomials, double* bernstein, std::size_t count) const;
+};
 
 //returns how many roots of polinomial are at most in search_area
 std::size_t upper_bound_roots(const polynomial::Monomials& polinomial, Interval search_area);
@@ -137,14 +184,196 @@ bool default_accept(const polynomial::Monomials& p, const Interval& i);
 //returns intervals with exactly one root in each (will not terminate if polynomial has roots with multiplicity > 1)
 //polinomial is called A in VikramSharma, start_zone is called I_0
 //parameter accept decides, if an interval should be accepted as final, despite still having multiple roots.
+//(see isolation::Engine in isolation_engine.hpp for a version with inlinable policies instead of the function pointer)
+//with accept == default_accept, polynomials of degree at most 4 are solved in closed form and only subdivided
+//if the result could not be certified (see low_degree.hpp). if trace is given, every node of the subdivision tree is recorded there (see trace.hpp)
 std::vector<Interval> descartes_root_isolation(const polynomial::Monomials& polinomial, const Interval& start_zone, 
+	bool(*accept)(const polynomial::Monomials& p, const Interval& i) = default_accept, Subdivision_Trace* trace = nullptr);
+
+//leaf of the subdivision tree built by descartes_root_isolation
+struct Frontier_Leaf
+{
+	Interval interval;
+	std::size_t roots;	//result of upper_bound_roots: 0 or 1 is exact, more only if the leaf was accepted by accept
+};
+
+//all leaves of a finished subdivision sorted left to right, covering start_zone without gaps
+using Isolation_Frontier = std::vector<Frontier_Leaf>;
+
+//same subdivision as descartes_root_isolation, but the leaves without roots are kept as well.
+//neighbouring leaves without roots are merged where possible to keep the frontier small
+Isolation_Frontier descartes_frontier(const polynomial::Monomials& polinomial, const Interval& start_zone,
 	bool(*accept)(const polynomial::Monomials& p, const Interval& i) = default_accept);
 
+//warm start for polynomials changing only a little: every leaf of previous is tested once with the new polynomial.
+//only leaves now holding more than one root are subdivided again, so if no root crossed a leaf boundary,
+//the cost is one upper_bound_roots call per leaf instead of a new subdivision from scratch.
+Isolation_Frontier repair_frontier(const polynomial::Monomials& polinomial, const Isolation_Frontier& previous,
+	bool(*accept)(const polynomial::Monomials& p, const Interval& i) = default_accept);
+
+//intervals of all leaves containing roots, left to right
+std::vector<Interval> root_intervals(const Isolation_Frontier& frontier);
+
+//persistent index over the roots of one polynomial for many "how many roots in [a, b]" queries.
+//the isolating intervals are computed once, queries are answered by binary search.
+//only an isolating interval cut by a range end is refined (by bisection, using only the sign of the polynomial)
+//and the refined interval is kept for later queries.
+class Root_Index
+{
+private:
+	polynomial::Monomials polinomial;
+	std::vector<Frontier_Leaf> leaves;	//only leaves containing roots, left to right
+	std::vector<std::size_t> roots_before;	//roots_before[i] is the number of roots in leaves[0] ... leaves[i - 1]
+
+	//index of the first leaf not lying completely left of x
+	std::size_t first_not_before(double x) const;
+	//refines the leaf with x in its interior (if any) until x is no longer inside
+	void cut_at(double x);
+	//[first, last) indices of leaves inside range after cutting at both ends
+	std::pair<std::size_t, std::size_t> leaves_in(const Interval& range);
+
+public:
+	Root_Index(const polynomial::Monomials& polinomial_, const Interval& start_zone,
+		bool(*accept)(const polynomial::Monomials& p, const Interval& i) = default_accept);
+
+	std::size_t count_roots() const { return this->roots_before.back(); }
+
+	//counts roots in the closed interval range. 
+	//roots accepted as cluster by accept can not be separated and count fully if their interval intersects range.
+	std::size_t count_roots(const Interval& range);
+
+	//isolating intervals of all roots in range, left to right
+	std::vector<Interval> roots_in(const Interval& range);
+};
+
 std::pair<polynomial::Bernstein, polynomial::Bernstein> de_casteljau_split(const polynomial::Bernstein& polynomial);
 
-std::vector<Interval> descartes_root_isolation(const polynomial::Bernstein& polynomial);
+//splits at polynomial.interval.min + t * polynomial.interval.width() with t in (0, 1).
+//(t = 0.5 gives exactly the same result as the version above)
+std::pair<polynomial::Bernstein, polynomial::Bernstein> de_casteljau_split(const polynomial::Bernstein& polynomial, double t);
+
+//accepts intervals narrower than 0.000001 as final
+std::vector<Interval> descartes_root_isolation(const polynomial::Bernstein& polynomial, Subdivision_Trace* trace = nullptr);
+
+//returns { p, p', p'', ... } with count elements, all derivatives beyond p.degree() are the zero polynomial { 0.0 }
+std::vector<polynomial::Monomials> derivative_family(const polynomial::Monomials& p, std::size_t count);
 
+//isolates the roots of all members in start_zone on one shared subdivision tree in bernstein base,
+//e.g. of derivative_family(p, 3) to get roots, extrema and inflection points of p at once.
+//all members still unresolved in a node are split together as one interleaved block of coefficients,
+//a member retires from a node as soon as it has at most one sign variation there (or the node is narrower than min_width).
+//result[i] holds the intervals of members[i] in the same order as descartes_root_isolation for polynomial::Bernstein.
+std::vector<std::vector<Interval>> family_root_isolation(const std::vector<polynomial::Monomials>& members, const Interval& start_zone,
+	double min_width = 0.000001);
 
+//isolates the solutions of p(x) = levels[i] for all levels at once (levels must be sorted ascending).
+//subtracting a level shifts every bernstein coefficient by it, so one bernstein representation and one shared
+//subdivision tree serve all levels: a level outside [min, max] of the coefficients of a node has no solution there
+//(convex hull property), thus each node finds its still active levels by binary search and drops the rest with their subtrees.
+//result[i] holds the intervals for levels[i] in the same order as descartes_root_isolation for polynomial::Bernstein,
+//intervals narrower than min_width are accepted as final.
+std::vector<std::vector<Interval>> level_set_isolation(const polynomial::Bernstein& polynomial, const std::vector<double>& levels,
+	double min_width = 0.000001);
+
+//converts polinomial to bernstein base relative to start_zone once for all levels
+std::vector<std::vector<Interval>> level_set_isolation(const polynomial::Monomials& polinomial, const Interval& start_zone,
+	const std::vector<double>& levels, double min_width = 0.000001);
+
+
+
+
+
+
+//query driven variants of descartes_root_isolation: the subdivision is ordered by a priority queue
+//and stops as soon as the requested k roots are certified, subtrees which can not contain a better root are never explored.
+
+//the k smallest roots in start_zone, left to right
+std::vector<Interval> smallest_roots(const polynomial::Monomials& polinomial, const Interval& start_zone, std::size_t k = 1,
+	bool(*accept)(const polynomial::Monomials& p, const Interval& i) = default_accept);
+
+//the k smallest roots in start_zone not smaller than threshold, left to right
+std::vector<Interval> roots_above(const polynomial::Monomials& polinomial, const Interval& start_zone, double threshold, std::size_t k = 1,
+	bool(*accept)(const polynomial::Monomials& p, const Interval& i) = default_accept);
+
+//the k roots in start_zone closest to target, closest first. 
+//intervals are refined by bisection until it is certain, which root is closer (as far as doubles allow)
+std::vector<Interval> nearest_roots(const polynomial::Monomials& polinomial, const Interval& start_zone, double target, std::size_t k = 1,
+	bool(*accept)(const polynomial::Monomials& p, const Interval& i) = default_accept);
+
+//order in which the lazy root isolation yields its intervals
+enum class Root_Order
+{
+	any,			//same order as descartes_root_isolation
+	left_to_right,
+};
+
+//input iterator over Root_Stream or Bernstein_Root_Stream, to use them in range based for loops
+template<typename Stream>
+class Root_Stream_Iterator
+{
+private:
+	Stream* stream;	//nullptr marks the end
+	std::optional<Interval> current;
+
+public:
+	Root_Stream_Iterator(Stream* stream_) :stream(stream_), current(stream_ ? stream_->next() : std::nullopt) {
+		if (!this->current) {
+			this->stream = nullptr;
+		}
+	}
+
+	const Interval& operator*() const { return *this->current; }
+	const Interval* operator->() const { return &*this->current; }
+
+	Root_Stream_Iterator& operator++() {
+		this->current = this->stream->next();
+		if (!this->current) {
+			this->stream = nullptr;
+		}
+		return *this;
+	}
+
+	bool operator==(const Root_Stream_Iterator& other) const { return this->stream == other.stream; }
+	bool operator!=(const Root_Stream_Iterator& other) const { return this->stream != other.stream; }
+};
+
+//lazy version of descartes_root_isolation: each call of next() explores the subdivision tree only 
+//until the next interval is certified. abandoning the stream early wastes no work.
+class Root_Stream
+{
+private:
+	polynomial::Monomials polinomial;
+	bool(*accept)(const polynomial::Monomials& p, const Interval& i);
+	Root_Order order;
+	std::vector<Interval> search_intervals;
+
+public:
+	Root_Stream(const polynomial::Monomials& polinomial_, const Interval& start_zone, Root_Order order_ = Root_Order::left_to_right,
+		bool(*accept_)(const polynomial::Monomials& p, const Interval& i) = default_accept);
+
+	//returns std::nullopt if there are no roots left
+	std::optional<Interval> next();
+
+	Root_Stream_Iterator<Root_Stream> begin() { return Root_Stream_Iterator<Root_Stream>(this); }
+	Root_Stream_Iterator<Root_Stream> end() { return Root_Stream_Iterator<Root_Stream>(nullptr); }
+};
+
+//lazy version of descartes_root_isolation for polynomial::Bernstein
+class Bernstein_Root_Stream
+{
+private:
+	Root_Order order;
+	std::vector<polynomial::Bernstein> search_objects;
+
+public:
+	Bernstein_Root_Stream(const polynomial::Bernstein& polynomial, Root_Order order_ = Root_Order::left_to_right);
+
+	//returns std::nullopt if there are no roots left
+	std::optional<Interval> next();
+
+	Root_Stream_Iterator<Bernstein_Root_Stream> begin() { return Root_Stream_Iterator<Bernstein_Root_Stream>(this); }
+	Root_Stream_Iterator<Bernstein_Root_Stream> end() { return Root_Stream_Iterator<Bernstein_Root_Stream>(nullptr); }
+};
 
 
 
@@ -160,4 +389,17 @@ std::ostream& operator<<(std::ostream& stream, const std::vector<T>& vec)
 		}
 	}
 	return stream << " }";
-}
\ No newline at end of file
+}
+
+template<typename T, std::size_t n>
+std::ostream& operator<<(std::ostream& stream, const Small_Vector<T, n>& vec)
+{
+	stream << "{ ";
+	if (vec.size() >= 1) {
+		stream << vec[0];
+		for (std::size_t i = 1; i < vec.size(); i++) {
+			stream << ", " << vec[i];
+		}
+	}
+	return stream << " }";
+}
@@ -0,0 +1,193 @@
+#include "descartes_c.h"
+#include "descartes.hpp"
+
+#include <new>
+#include <algorithm>
+
+struct descartes_workspace
+{
+	//stack of subdivision nodes, node i owns the coefficients [i * size, (i + 1) * size)
+	std::vector<double> node_coefficients;
+	std::vector<Interval> node_intervals;
+	std::vector<double> scratch;
+
+	//makes sure there is room for one more node, only allocates if the stack is larger than ever before.
+	//returns the offset of the coefficients of the new node in node_coefficients: a pointer would dangle after the next push
+	std::size_t push_node(std::size_t size, Interval interval)
+	{
+		const std::size_t index = this->node_intervals.size();
+		this->node_intervals.push_back(interval);
+		if (this->node_coefficients.size() < (index + 1) * size) {
+			this->node_coefficients.resize((index + 1) * size);
+		}
+		return index * size;
+	}
+};
+
+namespace c_interface {
+
+	double evaluate(const double* coefficients, std::size_t count, double x)
+	{
+		double result = coefficients[count - 1];
+		for (std::size_t i = count - 1; i > 0; i--) {
+			result = result * x + coefficients[i - 1];
+		}
+		return result;
+	}
+
+	std::size_t sign_changes(const double* b, std::size_t count)
+	{
+		std::size_t changes = 0;
+		double last = 0.0;
+		for (std::size_t i = 0; i < count; i++) {
+			if (b[i] != 0.0) {
+				changes += (last < 0.0 && b[i] > 0.0) || (last > 0.0 && b[i] < 0.0);
+				last = b[i];
+			}
+		}
+		return changes;
+	}
+
+	//de_casteljau_split without allocation, scratch needs count doubles
+	void split(const double* b, std::size_t count, double* lower, double* upper, double* scratch)
+	{
+		const std::size_t n = count - 1;
+		std::copy(b, b + count, scratch);
+		lower[0] = scratch[0];
+		upper[n] = scratch[n];
+		for (std::size_t i = 1; i <= n; i++) {
+			for (std::size_t j = 0; j <= n - i; j++) {
+				scratch[j] = 0.5 * scratch[j] + 0.5 * scratch[j + 1];
+			}
+			lower[i] = scratch[0];
+			upper[n - i] = scratch[n - i];
+		}
+	}
+
+} //namespace c_interface
+
+descartes_workspace* descartes_workspace_create(size_t max_degree)
+{
+	try {
+		descartes_workspace* workspace = new descartes_workspace();
+		const std::size_t expected_nodes = 64;
+		workspace->node_coefficients.reserve(expected_nodes * (max_degree + 1));
+		workspace->node_intervals.reserve(expected_nodes);
+		workspace->scratch.reserve(3 * (max_degree + 1));
+		return workspace;
+	}
+	catch (const std::bad_alloc&) {
+		return nullptr;
+	}
+}
+
+void descartes_workspace_destroy(descartes_workspace* workspace)
+{
+	delete workspace;
+}
+
+descartes_status descartes_isolate(descartes_workspace* workspace,
+	const double* coefficients, size_t count, double min, double max, double min_width,
+	double* intervals, size_t capacity, size_t* found)
+{
+	if (!workspace || !coefficients || count == 0 || !found || (capacity && !intervals) || !(min < max)) {
+		return DESCARTES_INVALID_ARGUMENT;
+	}
+	try {
+		workspace->node_intervals.clear();
+		if (workspace->scratch.size() < 3 * count) {
+			workspace->scratch.resize(3 * count);
+		}
+		double* const parent = workspace->scratch.data();
+		double* const scratch = parent + count;
+
+		const std::size_t start = workspace->push_node(count, Interval{ min, max });
+		polynomial::to_bernstein(coefficients, count, Interval{ min, max }, workspace->node_coefficients.data() + start);
+		std::size_t found_intervals = 0;
+
+		while (workspace->node_intervals.size()) {
+			//the parent is copied out, as its slot is reused by its children
+			const std::size_t index = workspace->node_intervals.size() - 1;
+			const Interval current = workspace->node_intervals[index];
+			std::copy_n(workspace->node_coefficients.data() + index * count, count, parent);
+			workspace->node_intervals.pop_back();
+
+			const std::size_t sign_variations = c_interface::sign_changes(parent, count);
+			if (sign_variations == 0) {
+				continue;
+			}
+			else if (sign_variations == 1 || current.width() < min_width) {
+				if (found_intervals < capacity) {
+					intervals[2 * found_intervals] = current.min;
+					intervals[2 * found_intervals + 1] = current.max;
+				}
+				found_intervals++;
+			}
+			else {
+				const double midpoint = (current.min / 2) + (current.max / 2);
+				const std::size_t lower = workspace->push_node(count, Interval{ current.min, midpoint });
+				const std::size_t upper = workspace->push_node(count, Interval{ midpoint, current.max });
+				double* const nodes = workspace->node_coefficients.data();
+				c_interface::split(parent, count, nodes + lower, nodes + upper, scratch);
+			}
+		}
+		*found = found_intervals;
+		return found_intervals <= capacity ? DESCARTES_OK : DESCARTES_BUFFER_TOO_SMALL;
+	}
+	catch (const std::bad_alloc&) {
+		return DESCARTES_OUT_OF_MEMORY;
+	}
+}
+
+descartes_status descartes_refine(const double* coefficients, size_t count, double* interval, double width)
+{
+	if (!coefficients || count == 0 || !interval || !(interval[0] <= interval[1])) {
+		return DESCARTES_INVALID_ARGUMENT;
+	}
+	double value_at_min = c_interface::evaluate(coefficients, count, interval[0]);
+	const double value_at_max = c_interface::evaluate(coefficients, count, interval[1]);
+	if (value_at_min == 0.0) {
+		interval[1] = interval[0];
+		return DESCARTES_OK;
+	}
+	if (value_at_max == 0.0) {
+		interval[0] = interval[1];
+		return DESCARTES_OK;
+	}
+	if ((value_at_min < 0.0) == (value_at_max < 0.0)) {
+		return DESCARTES_NO_SIGN_CHANGE;
+	}
+
+	while (interval[1] - interval[0] > width) {
+		const double midpoint = (interval[0] / 2) + (interval[1] / 2);
+		if (midpoint <= interval[0] || midpoint >= interval[1]) {
+			break;	//no double left inbetween
+		}
+		const double value_at_midpoint = c_interface::evaluate(coefficients, count, midpoint);
+		if (value_at_midpoint == 0.0) {
+			interval[0] = interval[1] = midpoint;
+		}
+		else if ((value_at_min < 0.0) != (value_at_midpoint < 0.0)) {
+			interval[1] = midpoint;
+		}
+		else {
+			interval[0] = midpoint;
+			value_at_min = value_at_midpoint;
+		}
+	}
+	return DESCARTES_OK;
+}
+
+descartes_status descartes_to_bernstein(const double* coefficients, size_t count, double min, double max, double* bernstein)
+{
+	if (!coefficients || count == 0 || !bernstein || !(min < max)) {
+		return DESCARTES_INVALID_ARGUMENT;
+	}
+	polynomial::to_bernstein(coefficients, count, Interval{ min, max }, bernstein);
+	return DESCARTES_OK;
+}
+
+double descartes_evaluate(const double* coefficients, size_t count, double x)
+{
+	return count ? c_interface::evaluate(coefficients, count, x) : 0.0;
+}
@@ -0,0 +1,65 @@
+#ifndef DESCARTES_C_H
+#define DESCARTES_C_H
+
+/* stable C interface to the root isolation, e.g. for the haskell port (see Haskell/DescartesFFI.hs).
+ * polynomials are passed as count = degree + 1 coefficients in little endian (coefficients[i] belongs to x^i),
+ * all results are written into caller owned buffers.
+ * a workspace holds all memory needed while isolating and is reused between calls,
+ * so after the first call with a given degree no more memory is allocated.
+ * a workspace must not be used by two threads at the same time. */
+
+#include <stddef.h>
+
+#if defined(DESCARTES_C_STATIC)	/* compiled into the program itself, e.g. for the checks in main.cpp */
+	#define DESCARTES_API
+#elif defined(_WIN32)
+	#if defined(DESCARTES_C_EXPORTS)
+		#define DESCARTES_API __declspec(dllexport)
+	#else
+		#define DESCARTES_API __declspec(dllimport)
+	#endif
+#else
+	#define DESCARTES_API __attribute__((visibility("default")))
+#endif
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+typedef enum descartes_status
+{
+	DESCARTES_OK = 0,
+	DESCARTES_INVALID_ARGUMENT = 1,
+	DESCARTES_BUFFER_TOO_SMALL = 2,	/* result did not fit, the needed size is still reported */
+	DESCARTES_OUT_OF_MEMORY = 3,
+	DESCARTES_NO_SIGN_CHANGE = 4,	/* refine got an interval without sign change at its ends */
+} descartes_status;
+
+typedef struct descartes_workspace descartes_workspace;
+
+/* max_degree is only a hint how much memory to reserve up front, higher degrees are still accepted */
+DESCARTES_API descartes_workspace* descartes_workspace_create(size_t max_degree);
+DESCARTES_API void descartes_workspace_destroy(descartes_workspace* workspace);
+
+/* isolates the roots in [min, max] by subdivision in bernstein base, same algorithm as descartes_root_isolation for polynomial::Bernstein.
+ * intervals narrower than min_width are accepted as final.
+ * intervals receives the found intervals as pairs (min, max), at most capacity of them.
+ * found receives the number of intervals, also if it exceeds capacity (then DESCARTES_BUFFER_TOO_SMALL is returned). */
+DESCARTES_API descartes_status descartes_isolate(descartes_workspace* workspace,
+	const double* coefficients, size_t count, double min, double max, double min_width,
+	double* intervals, size_t capacity, size_t* found);
+
+/* shrinks interval (pair (min, max)) by bisection until it is at most width wide.
+ * the polynomial must have different signs at both ends of the interval. */
+DESCARTES_API descartes_status descartes_refine(const double* coefficients, size_t count, double* interval, double width);
+
+/* writes the count bernstein coefficients relative to [min, max] into bernstein */
+DESCARTES_API descartes_status descartes_to_bernstein(const double* coefficients, size_t count, double min, double max, double* bernstein);
+
+DESCARTES_API double descartes_evaluate(const double* coefficients, size_t count, double x);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* DESCARTES_C_H */
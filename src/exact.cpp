@@ -0,0 +1,341 @@
+#include "exact.hpp"
+
+#include <algorithm>
+#include <limits>
+#include <cassert>
+
+using namespace multiprecision;
+
+namespace exact {
+
+	//all operations return false if the result does not fit, Big_Int always fits
+
+	bool add(std::int64_t a, std::int64_t b, std::int64_t& result)
+	{
+		if ((b > 0 && a > std::numeric_limits<std::int64_t>::max() - b) ||
+			(b < 0 && a < std::numeric_limits<std::int64_t>::min() - b))
+		{
+			return false;
+		}
+		result = a + b;
+		return true;
+	}
+
+	bool add(const Big_Int& a, const Big_Int& b, Big_Int& result)
+	{
+		result = a + b;
+		return true;
+	}
+
+	//a * 2^shift, conservatively only for results of absolute value below 2^62
+	bool shift_left(std::int64_t a, std::size_t shift, std::int64_t& result)
+	{
+		if (a == 0) {
+			result = 0;
+			return true;
+		}
+		if (shift >= 62) {
+			return false;
+		}
+		const std::int64_t rest = a >> (62 - shift);
+		if (rest != 0 && rest != -1) {
+			return false;
+		}
+		result = static_cast<std::int64_t>(static_cast<std::uint64_t>(a) << shift);
+		return true;
+	}
+
+	bool shift_left(const Big_Int& a, std::size_t shift, Big_Int& result)
+	{
+		result = a << shift;
+		return true;
+	}
+
+	int sign(std::int64_t a) { return (a > 0) - (a < 0); }
+	int sign(const Big_Int& a) { return a.sign(); }
+
+	std::size_t trailing_zeros(std::int64_t a)
+	{
+		std::size_t result = 0;
+		for (std::uint64_t bits = static_cast<std::uint64_t>(a); (bits & 1) == 0; bits >>= 1) {
+			result++;
+		}
+		return result;
+	}
+
+	std::size_t trailing_zeros(const Big_Int& a) { return a.trailing_zeros(); }
+
+	std::int64_t shift_right(std::int64_t a, std::size_t shift) { return a / (std::int64_t(1) << shift); }	//exact, as the bits are zero
+	Big_Int shift_right(const Big_Int& a, std::size_t shift) { return a >> shift; }
+
+	//p(x) -> p(x + 1), in place
+	template<typename Int>
+	bool taylor_shift_1(std::vector<Int>& p)
+	{
+		const std::size_t n = p.size() - 1;
+		for (std::size_t i = 0; i < n; i++) {
+			for (std::size_t j = n - 1; j + 1 > i; j--) {
+				if (!add(p[j], p[j + 1], p[j])) {
+					return false;
+				}
+			}
+		}
+		return true;
+	}
+
+	//sign variations of the bernstein coefficients of p over [0, 1], which are the coefficients of (x+1)^n * p(1/(x+1))
+	template<typename Int>
+	bool bernstein_variations(const std::vector<Int>& p, std::size_t& variations)
+	{
+		std::vector<Int> b(p.rbegin(), p.rend());
+		if (!taylor_shift_1(b)) {
+			return false;
+		}
+		variations = 0;
+		int last = 0;
+		for (const Int& c : b) {
+			const int current = sign(c);
+			if (current * last < 0) {
+				variations++;
+			}
+			last = current != 0 ? current : last;
+		}
+		return true;
+	}
+
+	//divides by the biggest power of two dividing all coefficients, this does not change the roots
+	template<typename Int>
+	void remove_power_of_two(std::vector<Int>& p)
+	{
+		std::size_t common = std::numeric_limits<std::size_t>::max();
+		for (const Int& c : p) {
+			if (sign(c) != 0) {
+				common = std::min(common, trailing_zeros(c));
+			}
+		}
+		if (common != 0 && common != std::numeric_limits<std::size_t>::max()) {
+			for (Int& c : p) {
+				c = shift_right(c, common);
+			}
+		}
+	}
+
+	//2^n * p(x/2) and 2^n * p((x+1)/2), the lower and upper half of [0, 1] mapped to [0, 1] again
+	template<typename Int>
+	bool halves(const std::vector<Int>& p, std::vector<Int>& lower, std::vector<Int>& upper)
+	{
+		const std::size_t n = p.size() - 1;
+		lower.resize(p.size());
+		for (std::size_t j = 0; j <= n; j++) {
+			if (!shift_left(p[j], n - j, lower[j])) {
+				return false;
+			}
+		}
+		upper = lower;
+		return taylor_shift_1(upper);
+	}
+
+	//p(x) / (x - 1), p(1) must be zero
+	template<typename Int>
+	bool divide_by_x_minus_1(std::vector<Int>& p)
+	{
+		for (std::size_t j = p.size() - 1; j-- > 1;) {
+			if (!add(p[j], p[j + 1], p[j])) {
+				return false;
+			}
+		}
+		p.erase(p.begin());
+		return true;
+	}
+
+	struct Node
+	{
+		//the polynomial mapped from the interval of this node to [0, 1], only one of both is used
+		std::vector<std::int64_t> small;
+		std::vector<Big_Int> big;
+		bool promoted;
+
+		Big_Int index;	//the node covers [index, index + 1] * 2^(zone_exponent - depth) - 2^(zone_exponent - 1)
+		std::size_t depth;
+		std::size_t point;	//if not 0, no node but a root of this multiplicity at the left end of the interval described by index and depth
+	};
+
+	Big_Float left_end(const Big_Int& index, std::size_t depth, std::int64_t zone_exponent)
+	{
+		return Big_Float(index, zone_exponent - static_cast<std::int64_t>(depth)) - Big_Float(Big_Int(1), zone_exponent - 1);
+	}
+
+	template<typename Int>
+	std::vector<Int>& polynomial_of(Node& node);
+	template<> std::vector<std::int64_t>& polynomial_of(Node& node) { return node.small; }
+	template<> std::vector<Big_Int>& polynomial_of(Node& node) { return node.big; }
+
+	void promote(Node& node)
+	{
+		if (!node.promoted) {
+			node.big.assign(node.small.begin(), node.small.end());
+			node.small.clear();
+			node.promoted = true;
+		}
+	}
+
+	//demotes if all coefficients fit into std::int64_t again
+	void try_demote(Node& node)
+	{
+		std::vector<std::int64_t> small(node.big.size());
+		for (std::size_t i = 0; i < node.big.size(); i++) {
+			if (!node.big[i].to_int64(small[i])) {
+				return;
+			}
+		}
+		node.small = std::move(small);
+		node.big.clear();
+		node.promoted = false;
+	}
+
+	enum class Outcome { overflow, discard, result, split };
+
+	//decides on node and computes its children (lower, point, upper) if it is split
+	template<typename Int>
+	Outcome process(Node& node, std::size_t max_depth, std::size_t& variations, Node& lower, Node& upper, std::size_t& midpoint_multiplicity)
+	{
+		std::vector<Int>& p = polynomial_of<Int>(node);
+		if (!bernstein_variations(p, variations)) {
+			return Outcome::overflow;
+		}
+		if (variations == 0) {
+			return Outcome::discard;
+		}
+		if (variations == 1 || node.depth >= max_depth) {
+			return Outcome::result;
+		}
+		std::vector<Int>& lower_p = polynomial_of<Int>(lower);
+		std::vector<Int>& upper_p = polynomial_of<Int>(upper);
+		if (!halves(p, lower_p, upper_p)) {
+			return Outcome::overflow;
+		}
+		midpoint_multiplicity = 0;
+		while (sign(upper_p.front()) == 0) {
+			midpoint_multiplicity++;
+			upper_p.erase(upper_p.begin());
+			if (!divide_by_x_minus_1(lower_p)) {
+				return Outcome::overflow;
+			}
+		}
+		remove_power_of_two(lower_p);
+		remove_power_of_two(upper_p);
+		return Outcome::split;
+	}
+
+	//all roots lie in (-2^(e-1), 2^(e-1)) (cauchy bound 1 + max |a_i / a_n|)
+	std::int64_t zone_exponent(const std::vector<Big_Int>& p)
+	{
+		std::size_t biggest = 0;
+		for (const Big_Int& c : p) {
+			biggest = std::max(biggest, c.bit_length());
+		}
+		const std::int64_t bound = static_cast<std::int64_t>(biggest) - static_cast<std::int64_t>(p.back().bit_length()) + 2;
+		return std::max<std::int64_t>(bound, 1) + 1;
+	}
+
+} //namespace exact
+
+Interval Dyadic_Interval::to_interval() const
+{
+	return Interval{ this->min.to_double(Rounding::down), this->max.to_double(Rounding::up) };
+}
+
+std::vector<Dyadic_Interval> exact_root_isolation(const std::vector<Big_Int>& coefficients, std::size_t max_depth)
+{
+	std::vector<Big_Int> p = coefficients;
+	while (!p.empty() && p.back().is_zero()) {
+		p.pop_back();
+	}
+	if (p.empty()) {
+		throw std::exception("the zero polynomial has no isolated roots");
+	}
+	std::vector<Dyadic_Interval> result;
+	const std::int64_t e = exact::zone_exponent(p);
+
+	//roots at zero are found as root at the split point of the first node
+	//map (-2^(e-1), 2^(e-1)) to [0, 1]: q(y) = p(2^e * y - 2^(e-1)) = p(2^(e-1) * (2y - 1))
+	const std::size_t n = p.size() - 1;
+	for (std::size_t j = 0; j <= n; j++) {
+		p[j] = p[j] << ((e - 1) * j);
+	}
+	{
+		//p(x) -> p(x - 1) is p(-x) shifted by 1 and reflected back
+		for (std::size_t j = 1; j <= n; j += 2) {
+			p[j] = -p[j];
+		}
+		exact::taylor_shift_1(p);
+		for (std::size_t j = 1; j <= n; j += 2) {
+			p[j] = -p[j];
+		}
+	}
+	for (std::size_t j = 0; j <= n; j++) {
+		p[j] = p[j] << j;
+	}
+	exact::remove_power_of_two(p);
+
+	std::vector<exact::Node> stack;
+	stack.push_back(exact::Node{ {}, std::move(p), true, Big_Int(0), 0, 0 });
+	exact::try_demote(stack.back());
+
+	while (!stack.empty()) {
+		exact::Node node = std::move(stack.back());
+		stack.pop_back();
+		const Big_Float min = exact::left_end(node.index, node.depth, e);
+		if (node.point != 0) {
+			result.push_back(Dyadic_Interval{ min, min, node.point });
+			continue;
+		}
+
+		exact::Node lower = { {}, {}, node.promoted, node.index << 1, node.depth + 1, 0 };
+		exact::Node upper = { {}, {}, node.promoted, (node.index << 1) + Big_Int(1), node.depth + 1, 0 };
+		std::size_t variations = 0;
+		std::size_t midpoint_multiplicity = 0;
+		exact::Outcome outcome = node.promoted ?
+			exact::process<Big_Int>(node, max_depth, variations, lower, upper, midpoint_multiplicity) :
+			exact::process<std::int64_t>(node, max_depth, variations, lower, upper, midpoint_multiplicity);
+		if (outcome == exact::Outcome::overflow) {
+			exact::promote(node);
+			lower.promoted = upper.promoted = true;
+			lower.small.clear();
+			upper.small.clear();
+			outcome = exact::process<Big_Int>(node, max_depth, variations, lower, upper, midpoint_multiplicity);
+		}
+
+		switch (outcome) {
+		case exact::Outcome::discard:
+			break;
+		case exact::Outcome::result:
+			result.push_back(Dyadic_Interval{ min, exact::left_end(node.index + Big_Int(1), node.depth, e), variations });
+			break;
+		case exact::Outcome::split:
+			if (lower.promoted) {
+				exact::try_demote(lower);
+				exact::try_demote(upper);
+			}
+			//pushed in reverse, so the lower half is processed first
+			if (midpoint_multiplicity != 0) {
+				exact::Node point = { {}, {}, false, upper.index, upper.depth, midpoint_multiplicity };
+				stack.push_back(std::move(upper));
+				stack.push_back(std::move(point));
+			}
+			else {
+				stack.push_back(std::move(upper));
+			}
+			stack.push_back(std::move(lower));
+			break;
+		case exact::Outcome::overflow:
+			assert(false);	//Big_Int never overflows
+		}
+	}
+	return result;
+}
+
+std::vector<Dyadic_Interval> exact_root_isolation(const std::vector<std::int64_t>& coefficients, std::size_t max_depth)
+{
+	return exact_root_isolation(std::vector<Big_Int>(coefficients.begin(), coefficients.end()), max_depth);
+}
@@ -0,0 +1,34 @@
+#pragma once
+
+#include <vector>
+#include <cstdint>
+#include <cstddef>
+
+#include "descartes.hpp"
+#include "multiprecision.hpp"
+
+//interval with dyadic endpoints (exact multiprecision::Big_Float values)
+struct Dyadic_Interval
+{
+	multiprecision::Big_Float min;
+	multiprecision::Big_Float max;
+	//1 for isolating intervals (certified to hold exactly one root in the open interval).
+	//for min == max (a root hit exactly) its multiplicity.
+	//intervals still holding more sign variations at max_depth have their descartes bound here (e.g. for multiple roots)
+	std::size_t roots;
+
+	bool is_point() const { return this->min == this->max; }
+
+	//rounded outwards, so the result contains the exact interval
+	Interval to_interval() const;
+};
+
+//isolates all real roots of the polynomial with integer coefficients (coefficients[i] belongs to x^i) without any rounding.
+//works like descartes_root_isolation for polynomial::Bernstein, but every node of the subdivision tree keeps the polynomial
+//mapped to [0, 1] with integer coefficients: the (unnormalized) bernstein coefficients are the coefficients of
+//(x+1)^n * p(1/(x+1)), the two halves are 2^n * p(x/2) and 2^n * p((x+1)/2), so only additions and shifts are needed.
+//a root exactly at a split point is found as such and divided out, nothing is ever given up because of rounding.
+//the coefficients are std::int64_t as long as they fit (every operation is checked), only then multiprecision::Big_Int.
+//nodes deeper than max_depth are returned with roots > 1. the result is in ascending order.
+std::vector<Dyadic_Interval> exact_root_isolation(const std::vector<multiprecision::Big_Int>& coefficients, std::size_t max_depth = 256);
+std::vector<Dyadic_Interval> exact_root_isolation(const std::vector<std::int64_t>& coefficients, std::size_t max_depth = 256);
@@ -1,6 +1,10 @@
 #include "graph.hpp"
 
 #include <algorithm>
+#include <atomic>
+#include <thread>
+#include <mutex>
+#include <exception>
 
 Vec2D Plot::math_to_svg(Vec2D math) const
 {
@@ -74,6 +78,16 @@ void Plot::add_polynomial(const polynomial::Bernstein& p, const SVG::Style& styl
 	this->picture.add_line_path(graph, false, style);
 }
 
+void Plot::add_samples(const Sample_Grid& grid, const double* ys, const SVG::Style& style)
+{
+	std::vector<Vec2D> graph;
+	graph.reserve(grid.xs.size());
+	for (std::size_t k = 0; k < grid.xs.size(); k++) {
+		graph.push_back(this->math_to_svg(Vec2D{ grid.xs[k], ys[k] }));
+	}
+	this->picture.add_line_path(graph, false, style);
+}
+
 void Plot::add_control_polygon(const polynomial::Bernstein& p, const SVG::Style& style)
 {
 	std::vector<Vec2D> points;
@@ -96,3 +110,101 @@ void Plot::add_interval(Interval interval, const RGB& color)
 	this->picture.add_line(upper_left, lower_left, SVG::Style{ 0.2, color });
 	this->picture.add_line(upper_right, lower_right, SVG::Style{ 0.2, color });
 }
+
+void Plot::add_subdivision_trace(const Subdivision_Trace& trace, const RGB& color)
+{
+	const std::vector<Trace_Record> records = trace.snapshot();
+	std::uint32_t max_depth = 0;
+	for (const auto& record : records) {
+		max_depth = std::max(max_depth, record.depth);
+	}
+	const double row_height = std::min(3.0, (svg_max.y - 1) / (max_depth + 1));
+
+	for (const auto& record : records) {
+		const RGB fill_color = 
+			record.decision == isolation::Decision::split ? color : 
+			record.decision == isolation::Decision::root ? rgb::green : rgb::grey;
+		const double top = 1 + record.depth * row_height;
+		const double bottom = top + row_height * 0.8;
+		const double left = std::max(record.interval.min, this->min.x) * this->x_scale;
+		const double right = std::min(record.interval.max, this->max.x) * this->x_scale;
+
+		this->picture.add_line_path({ {left, top}, {right, top}, {right, bottom}, {left, bottom} }, true, svg_style::fill(fill_color));
+	}
+}
+
+Sample_Grid::Sample_Grid(double x_min, double x_max, std::size_t count)
+	:xs(count)
+{
+	const double dx = (x_max - x_min) / count;
+	for (std::size_t k = 0; k < count; k++) {
+		this->xs[k] = x_min + k * dx;
+	}
+}
+
+void evaluate_on_grid(const polynomial::Monomials& p, const Sample_Grid& grid, double* values)
+{
+	const std::size_t count = grid.xs.size();
+	const double* const xs = grid.xs.data();
+	std::fill(values, values + count, p[p.degree()]);
+	for (int i = p.degree() - 1; i >= 0; i--) {
+		const double coefficient = p[i];
+		for (std::size_t k = 0; k < count; k++) {
+			values[k] = values[k] * xs[k] + coefficient;
+		}
+	}
+}
+
+void plot_batch(std::size_t job_count, const std::function<Plot_Job(std::size_t)>& job_at, const Batch_Plot_Settings& settings)
+{
+	const Sample_Grid grid(-settings.x_max, settings.x_max, settings.samples);
+
+	std::atomic<std::size_t> next_job = 0;
+	std::atomic<bool> failed = false;
+	std::exception_ptr first_exception;
+	std::mutex exception_mutex;
+
+	const auto work = [&]() {
+		std::vector<double> values(grid.xs.size());
+		while (!failed) {
+			const std::size_t index = next_job++;
+			if (index >= job_count) {
+				return;
+			}
+			try {
+				const Plot_Job job = job_at(index);
+				Plot plot(job.name, settings.x_max, settings.y_max);
+				for (const auto& p : job.polynomials) {
+					evaluate_on_grid(p, grid, values.data());
+					plot.add_samples(grid, values.data(), settings.style);
+				}
+				for (const auto& interval : job.intervals) {
+					plot.add_interval(interval, settings.interval_color);
+				}
+			}
+			catch (...) {
+				std::lock_guard lock(exception_mutex);
+				if (!first_exception) {
+					first_exception = std::current_exception();
+				}
+				failed = true;
+			}
+		}
+	};
+
+	std::size_t threads = settings.threads != 0 ? settings.threads : std::max(1u, std::thread::hardware_concurrency());
+	threads = std::min(threads, std::max<std::size_t>(job_count, 1));
+	{
+		std::vector<std::thread> workers;
+		workers.reserve(threads);
+		for (std::size_t i = 0; i < threads; i++) {
+			workers.emplace_back(work);
+		}
+		for (auto& worker : workers) {
+			worker.join();
+		}
+	}
+	if (first_exception) {
+		std::rethrow_exception(first_exception);
+	}
+}
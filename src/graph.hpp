@@ -1,7 +1,24 @@
 #pragma once
 
+#include <vector>
+#include <string>
+#include <functional>
+
 #include "to_svg.hpp"
 #include "descartes.hpp"
+#include "trace.hpp"
+
+//x values shared by every polynomial drawn in one batch, so they are computed only once
+struct Sample_Grid
+{
+	std::vector<double> xs;
+
+	Sample_Grid(double x_min, double x_max, std::size_t count);
+};
+
+//values[k] = p(grid.xs[k]). horner runs over the whole grid at once (one pass per coefficient),
+//so the inner loop has no dependencies between iterations and is vectorized by the compiler
+void evaluate_on_grid(const polynomial::Monomials& p, const Sample_Grid& grid, double* values);
 
 class Plot
 {
@@ -19,6 +36,36 @@ public:
 
 	void add_polynomial(const polynomial::Monomials& p, const SVG::Style& style = svg_style::blue_line);
 	void add_polynomial(const polynomial::Bernstein& p, const SVG::Style& style = svg_style::blue_line);
+	//draws the graph through (grid.xs[k], ys[k]) for all k
+	void add_samples(const Sample_Grid& grid, const double* ys, const SVG::Style& style = svg_style::blue_line);
 	void add_control_polygon(const polynomial::Bernstein& p, const SVG::Style& style = svg_style::red_line);
 	void add_interval(Interval interval, const RGB& color = RGB{ 0, 200, 0 });
-};
\ No newline at end of file
+
+	//draws every node of trace as band below the x axis, one row per depth (the root of the tree directly under the axis).
+	//split nodes get color, nodes accepted as root green and discarded nodes grey
+	void add_subdivision_trace(const Subdivision_Trace& trace, const RGB& color = rgb::steel_blue);
+};
+
+//everything drawn into one file of a batch
+struct Plot_Job
+{
+	std::string name;
+	std::vector<polynomial::Monomials> polynomials;
+	std::vector<Interval> intervals;	//typically the root intervals of polynomials
+};
+
+struct Batch_Plot_Settings
+{
+	double x_max;
+	double y_max;
+	std::size_t samples = 500;
+	std::size_t threads = 0;	//0 uses std::thread::hardware_concurrency()
+	SVG::Style style = svg_style::blue_line;
+	RGB interval_color = RGB{ 0, 200, 0 };
+};
+
+//renders job_count plots concurrently, all with the same view and sample grid.
+//job_at(index) is called from the worker threads and only once per index, each worker builds, draws and writes
+//one job at a time. thus at most settings.threads jobs (and svg buffers) exist at once, no matter how many there are in total.
+//if job_at throws, no further jobs are started and the first exception is rethrown after all workers finished
+void plot_batch(std::size_t job_count, const std::function<Plot_Job(std::size_t)>& job_at, const Batch_Plot_Settings& settings);
@@ -0,0 +1,447 @@
+#pragma once
+
+#include <vector>
+#include <deque>
+#include <algorithm>
+#include <random>
+#include <cmath>
+
+#include "descartes.hpp"
+
+//descartes_root_isolation as template over its policies, so every use can compile its own fully inlined version.
+//descartes_root_isolation itself is the instantiation with Accept_Function (Monomials) or Min_Width (Bernstein)
+//and all other policies left at their defaults.
+namespace isolation {
+
+	//what happened to a node of the subdivision tree
+	enum class Decision
+	{
+		discard,	//no roots
+		root,		//accepted as final interval
+		split,
+	};
+
+	///////////////////////////////////////////////////////////////////////////////////////////////////
+	//termination policies: decide if a node with more than one sign variation is accepted anyway
+
+	//wraps the old function pointer interface
+	struct Accept_Function
+	{
+		bool(*accept)(const polynomial::Monomials& p, const Interval& i) = default_accept;
+
+		bool operator()(const polynomial::Monomials& p, const Interval& i, std::size_t) const { return this->accept(p, i); }
+	};
+
+	struct Min_Width
+	{
+		double width;
+
+		bool operator()(const polynomial::Monomials&, const Interval& i, std::size_t) const { return i.width() < this->width; }
+		bool operator()(const polynomial::Bernstein& b, std::size_t) const { return b.interval.width() < this->width; }
+	};
+
+	struct Max_Depth
+	{
+		std::size_t depth;
+
+		bool operator()(const polynomial::Monomials&, const Interval&, std::size_t depth_) const { return depth_ >= this->depth; }
+		bool operator()(const polynomial::Bernstein&, std::size_t depth_) const { return depth_ >= this->depth; }
+	};
+
+	//(will not terminate if polynomial has roots with multiplicity > 1)
+	struct Never
+	{
+		bool operator()(const polynomial::Monomials&, const Interval&, std::size_t) const { return false; }
+		bool operator()(const polynomial::Bernstein&, std::size_t) const { return false; }
+	};
+
+	///////////////////////////////////////////////////////////////////////////////////////////////////
+	//split policies: for polynomial::Monomials return the point to split the interval at,
+	//for polynomial::Bernstein the parameter t in (0, 1) passed to de_casteljau_split
+
+	struct Midpoint_Split
+	{
+		double operator()(const polynomial::Monomials&, const Interval& i) const { return (i.min / 2) + (i.max / 2); }
+		double operator()(const polynomial::Bernstein&) const { return 0.5; }
+	};
+
+	namespace split_point {
+
+		//split parameters too close to an end would make one child hardly smaller than its parent
+		constexpr double min_t = 1.0 / 16.0;
+		constexpr double max_t = 15.0 / 16.0;
+
+		inline double clamp(double t) { return std::isfinite(t) ? std::clamp(t, min_t, max_t) : 0.5; }
+
+		//middle of the widest gap between neighbouring crossings of the control polygon with the x axis
+		//(control point i lies at t = i / n). 0.5 if there are less than two crossings
+		inline double between_crossings(const double* b, std::size_t size)
+		{
+			const double n = static_cast<double>(size - 1);
+			double last_crossing = -1.0;
+			double best_gap = 0.0;
+			double best_t = 0.5;
+			std::size_t last_nonzero = size;
+			for (std::size_t j = 0; j < size; j++) {
+				if (b[j] == 0.0) {
+					continue;
+				}
+				if (last_nonzero != size && (b[last_nonzero] < 0.0) != (b[j] < 0.0)) {
+					const double i = static_cast<double>(last_nonzero);
+					const double crossing = (i + (j - i) * b[last_nonzero] / (b[last_nonzero] - b[j])) / n;
+					if (last_crossing >= 0.0 && crossing - last_crossing > best_gap) {
+						best_gap = crossing - last_crossing;
+						best_t = (crossing + last_crossing) / 2.0;
+					}
+					last_crossing = crossing;
+				}
+				last_nonzero = j;
+			}
+			return clamp(best_t);
+		}
+
+		//newton step from t = 0.5 for a cluster of multiplicity roots: t - multiplicity * b(t) / b'(t)
+		//(exact for b(t) = c * (t - t_0)^multiplicity, so a cluster is found in one step instead of one per bit)
+		inline double newton_estimate(const double* b, std::size_t size, std::size_t multiplicity)
+		{
+			//de casteljau at 0.5: the second to last row holds two points, their mean is the value, n times their difference the derivative
+			const std::size_t n = size - 1;
+			if (n == 0) {
+				return 0.5;
+			}
+			polynomial::Coefficients row(b, b + size);
+			for (std::size_t i = 1; i < n; i++) {
+				for (std::size_t j = 0; j <= n - i; j++) {
+					row[j] = 0.5 * row[j] + 0.5 * row[j + 1];
+				}
+			}
+			const double value = 0.5 * row[0] + 0.5 * row[1];
+			const double derivative = n * (row[1] - row[0]);
+			return 0.5 - multiplicity * value / derivative;
+		}
+
+		//the split is placed just beside the estimate t of a root (or cluster) on the side of 0.5,
+		//so the estimated root is not hit exactly and ends up in the smaller child
+		inline double beside_estimate(double t)
+		{
+			if (!std::isfinite(t) || t <= 0.0 || t >= 1.0) {
+				return 0.5;
+			}
+			return clamp(t < 0.5 ? t + 1.0 / 64.0 : t - 1.0 / 64.0);
+		}
+
+	} //namespace split_point
+
+	//splits between the roots estimated by the control polygon, so neighbouring roots are separated by the split
+	//and none of them lies on the split point
+	struct Control_Polygon_Split
+	{
+		double operator()(const polynomial::Monomials& p, const Interval& i) const {
+			polynomial::Coefficients b(p.size(), 0.0);
+			polynomial::to_bernstein(p.data(), p.size(), i, b.data());
+			return i.min + split_point::between_crossings(b.data(), b.size()) * i.width();
+		}
+		double operator()(const polynomial::Bernstein& b) const { return split_point::between_crossings(b.data(), b.size()); }
+	};
+
+	//one newton step from the midpoint, weighted with the number of sign variations as assumed multiplicity
+	//(as in ANewDsc by Sagraloff and Mehlhorn), estimates where the roots are concentrated.
+	//the split next to that estimate leaves them in a child much smaller than half of the parent
+	struct Newton_Split
+	{
+		double operator()(const polynomial::Monomials& p, const Interval& i) const {
+			polynomial::Coefficients b(p.size(), 0.0);
+			polynomial::to_bernstein(p.data(), p.size(), i, b.data());
+			const double t = split_point::newton_estimate(b.data(), b.size(), number_sign_changes(b));
+			return i.min + split_point::beside_estimate(t) * i.width();
+		}
+		double operator()(const polynomial::Bernstein& b) const {
+			return split_point::beside_estimate(split_point::newton_estimate(b.data(), b.size(), number_sign_changes(b)));
+		}
+	};
+
+	//random point in [3/8, 5/8], so no root lies exactly on a split point by construction of the input
+	struct Randomized_Split
+	{
+		std::minstd_rand generator;
+
+		Randomized_Split(unsigned seed = 1) :generator(seed) {}
+
+		double next() { return std::uniform_real_distribution<double>(0.375, 0.625)(this->generator); }
+
+		double operator()(const polynomial::Monomials&, const Interval& i) { return i.min + this->next() * i.width(); }
+		double operator()(const polynomial::Bernstein&) { return this->next(); }
+	};
+
+	///////////////////////////////////////////////////////////////////////////////////////////////////
+	//traversal policies: decide which node is processed next
+
+	//same order as the old descartes_root_isolation (upper half first)
+	struct Depth_First
+	{
+		template<typename Node>
+		struct Frontier
+		{
+			std::vector<Node> nodes;
+
+			bool empty() const { return this->nodes.empty(); }
+			void push(Node&& node) { this->nodes.push_back(std::move(node)); }
+			void push_children(Node&& lower, Node&& upper) {
+				this->nodes.push_back(std::move(lower));
+				this->nodes.push_back(std::move(upper));
+			}
+			Node pop() {
+				Node result = std::move(this->nodes.back());
+				this->nodes.pop_back();
+				return result;
+			}
+		};
+	};
+
+	//depth first, but lower half first, so the roots are found in ascending order
+	struct Left_To_Right
+	{
+		template<typename Node>
+		struct Frontier :Depth_First::Frontier<Node>
+		{
+			void push_children(Node&& lower, Node&& upper) {
+				this->nodes.push_back(std::move(upper));
+				this->nodes.push_back(std::move(lower));
+			}
+		};
+	};
+
+	//all nodes of one depth before the next depth
+	struct Breadth_First
+	{
+		template<typename Node>
+		struct Frontier
+		{
+			std::deque<Node> nodes;
+
+			bool empty() const { return this->nodes.empty(); }
+			void push(Node&& node) { this->nodes.push_back(std::move(node)); }
+			void push_children(Node&& lower, Node&& upper) {
+				this->nodes.push_back(std::move(lower));
+				this->nodes.push_back(std::move(upper));
+			}
+			Node pop() {
+				Node result = std::move(this->nodes.front());
+				this->nodes.pop_front();
+				return result;
+			}
+		};
+	};
+
+	///////////////////////////////////////////////////////////////////////////////////////////////////
+	//statistics policies: are told about every node of the subdivision tree
+
+	struct No_Statistics
+	{
+		void record(const Interval&, std::size_t, std::size_t, Decision) {}
+	};
+
+	struct Counting_Statistics
+	{
+		std::size_t nodes = 0;
+		std::size_t discarded = 0;
+		std::size_t roots = 0;
+		std::size_t splits = 0;
+		std::size_t max_depth = 0;
+
+		void record(const Interval&, std::size_t depth, std::size_t, Decision decision) {
+			this->nodes++;
+			this->max_depth = std::max(this->max_depth, depth);
+			switch (decision) {
+			case Decision::discard: this->discarded++; break;
+			case Decision::root:    this->roots++;     break;
+			case Decision::split:   this->splits++;    break;
+			}
+		}
+	};
+
+	///////////////////////////////////////////////////////////////////////////////////////////////////
+
+	//policies are stored by value and may carry state, e.g. the statistics can be read after a run
+	template<typename Termination, typename Split = Midpoint_Split, typename Traversal = Depth_First, typename Statistics = No_Statistics>
+	class Engine
+	{
+	public:
+		Termination termination;
+		Split split;
+		Statistics statistics;
+
+		Engine(Termination termination_ = {}, Split split_ = {}, Statistics statistics_ = {})
+			:termination(termination_), split(split_), statistics(statistics_)
+		{}
+
+		//returns intervals with exactly one root in each (or accepted by termination)
+		std::vector<Interval> operator()(const polynomial::Monomials& p, const Interval& start_zone);
+
+		std::vector<Interval> operator()(const polynomial::Bernstein& b);
+	};
+
+	template<typename Termination, typename Split, typename Traversal, typename Statistics>
+	std::vector<Interval> Engine<Termination, Split, Traversal, Statistics>::operator()(const polynomial::Monomials& p, const Interval& start_zone)
+	{
+		struct Node
+		{
+			Interval interval;
+			std::size_t depth;
+		};
+
+		std::vector<Interval> root_intervals;
+		root_intervals.reserve(p.degree());
+
+		typename Traversal::template Frontier<Node> search_intervals;	//called Q in VikramSharma
+		search_intervals.push(Node{ start_zone, 0 });
+
+		while (!search_intervals.empty()) {
+			const Node current = search_intervals.pop();
+
+			const auto roots_in_interval = upper_bound_roots(p, current.interval);
+			if (roots_in_interval == 0) {
+				this->statistics.record(current.interval, current.depth, roots_in_interval, Decision::discard);
+			}
+			else if (roots_in_interval == 1 || this->termination(p, current.interval, current.depth)) {
+				this->statistics.record(current.interval, current.depth, roots_in_interval, Decision::root);
+				root_intervals.push_back(current.interval);
+			}
+			else {
+				this->statistics.record(current.interval, current.depth, roots_in_interval, Decision::split);
+				const double split_point = this->split(p, current.interval);
+				search_intervals.push_children(
+					Node{ Interval{ current.interval.min, split_point }, current.depth + 1 },
+					Node{ Interval{ split_point, current.interval.max }, current.depth + 1 });
+			}
+		}
+		return root_intervals;
+	}
+
+	template<typename Termination, typename Split, typename Traversal, typename Statistics>
+	std::vector<Interval> Engine<Termination, Split, Traversal, Statistics>::operator()(const polynomial::Bernstein& b)
+	{
+		struct Node
+		{
+			polynomial::Bernstein polynomial;
+			std::size_t depth;
+		};
+
+		std::vector<Interval> root_intervals;
+		root_intervals.reserve(b.degree());
+
+		typename Traversal::template Frontier<Node> search_objects;
+		search_objects.push(Node{ b, 0 });
+
+		while (!search_objects.empty()) {
+			const Node current = search_objects.pop();
+			const Interval& interval = current.polynomial.interval;
+
+			const auto sign_variations = number_sign_changes(current.polynomial);
+			if (sign_variations == 0) {
+				this->statistics.record(interval, current.depth, sign_variations, Decision::discard);
+			}
+			else if (sign_variations == 1 || this->termination(current.polynomial, current.depth)) {
+				this->statistics.record(interval, current.depth, sign_variations, Decision::root);
+				root_intervals.push_back(interval);
+			}
+			else {
+				this->statistics.record(interval, current.depth, sign_variations, Decision::split);
+				auto [b1, b2] = de_casteljau_split(current.polynomial, this->split(current.polynomial));
+				search_objects.push_children(Node{ std::move(b1), current.depth + 1 }, Node{ std::move(b2), current.depth + 1 });
+			}
+		}
+		return root_intervals;
+	}
+
+	///////////////////////////////////////////////////////////////////////////////////////////////////
+
+	//descartes with quadratic interval refinement (QIR) as in ANewDsc by Sagraloff and Mehlhorn.
+	//every node carries a step count N = 2^log_steps. a node with k > 1 sign variations is taken as cluster of k roots:
+	//newton_estimate guesses where it lies and only the part of width 2 / N around the guess is kept, if it still has
+	//all k sign variations (then the rest of the node has none). N is squared after such a step, so every step gains twice
+	//as many bits as the last one. if the part lost variations, the node is bisected and N goes back to its square root.
+	//a cluster of width 2^-k is thus reached in O(log k) steps, where Engine needs k bisections.
+	template<typename Termination, typename Traversal = Depth_First, typename Statistics = No_Statistics>
+	class Newton_Engine
+	{
+	public:
+		static constexpr std::size_t min_log_steps = 2;
+		static constexpr std::size_t max_log_steps = 32;	//parts narrower than 2^-31 of their node gain too little precision
+
+		Termination termination;
+		Statistics statistics;
+		std::size_t newton_steps = 0;	//nodes replaced by a part of width 2 / N
+		std::size_t bisections = 0;		//failed newton steps and nodes where the estimate was outside of the node
+
+		Newton_Engine(Termination termination_ = {}, Statistics statistics_ = {})
+			:termination(termination_), statistics(statistics_)
+		{}
+
+		//returns intervals with exactly one root in each (or accepted by termination)
+		std::vector<Interval> operator()(const polynomial::Bernstein& b);
+
+		std::vector<Interval> operator()(const polynomial::Monomials& p, const Interval& start_zone) {
+			return (*this)(polynomial::to_bernstein(p, start_zone));
+		}
+	};
+
+	template<typename Termination, typename Traversal, typename Statistics>
+	std::vector<Interval> Newton_Engine<Termination, Traversal, Statistics>::operator()(const polynomial::Bernstein& b)
+	{
+		struct Node
+		{
+			polynomial::Bernstein polynomial;
+			std::size_t depth;
+			std::size_t log_steps;
+		};
+
+		std::vector<Interval> root_intervals;
+		root_intervals.reserve(b.degree());
+
+		typename Traversal::template Frontier<Node> search_objects;
+		search_objects.push(Node{ b, 0, min_log_steps });
+
+		while (!search_objects.empty()) {
+			Node current = search_objects.pop();
+			const Interval& interval = current.polynomial.interval;
+
+			const auto sign_variations = number_sign_changes(current.polynomial);
+			if (sign_variations == 0) {
+				this->statistics.record(interval, current.depth, sign_variations, Decision::discard);
+				continue;
+			}
+			if (sign_variations == 1 || this->termination(current.polynomial, current.depth)) {
+				this->statistics.record(interval, current.depth, sign_variations, Decision::root);
+				root_intervals.push_back(interval);
+				continue;
+			}
+			this->statistics.record(interval, current.depth, sign_variations, Decision::split);
+
+			const double steps = std::ldexp(1.0, static_cast<int>(current.log_steps));
+			const double t = split_point::newton_estimate(current.polynomial.data(), current.polynomial.size(), sign_variations);
+			if (std::isfinite(t) && t >= 0.0 && t <= 1.0) {
+				const double part = std::min(std::floor(t * steps), steps - 1.0);
+				const double part_min = std::max(part - 1.0, 0.0) / steps;
+				const double part_max = std::min(part + 1.0, steps) / steps;
+
+				polynomial::Bernstein candidate = part_max < 1.0 ? de_casteljau_split(current.polynomial, part_max).first : current.polynomial;
+				if (part_min > 0.0) {
+					candidate = de_casteljau_split(candidate, part_min / part_max).second;
+				}
+				if (number_sign_changes(candidate) == sign_variations) {
+					this->newton_steps++;
+					const std::size_t log_steps = std::min(2 * current.log_steps, max_log_steps);
+					search_objects.push(Node{ std::move(candidate), current.depth + 1, log_steps });
+					continue;
+				}
+			}
+			this->bisections++;
+			const std::size_t log_steps = std::max(current.log_steps / 2, min_log_steps);
+			auto [b1, b2] = de_casteljau_split(current.polynomial);
+			search_objects.push_children(Node{ std::move(b1), current.depth + 1, log_steps }, Node{ std::move(b2), current.depth + 1, log_steps });
+		}
+		return root_intervals;
+	}
+
+} //namespace isolation
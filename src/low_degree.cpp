@@ -0,0 +1,324 @@
+#include "low_degree.hpp"
+
+#include <cmath>
+#include <array>
+#include <limits>
+#include <algorithm>
+#include <cassert>
+
+namespace low_degree {
+
+	constexpr double nan = std::numeric_limits<double>::quiet_NaN();
+	constexpr double two_pi_thirds = 2.0943951023931954923;
+
+	//c2 * x^2 + c1 * x + c0
+	//q is computed without cancellation, the second root follows from vieta (x0 * x1 = c0 / c2)
+	void solve_quadratic(double c0, double c1, double c2, double* roots)
+	{
+		const double discriminant = c1 * c1 - 4.0 * c2 * c0;
+		const double q = -0.5 * (c1 + std::copysign(std::sqrt(discriminant), c1));	//NaN if discriminant < 0
+		roots[0] = q / c2;
+		roots[1] = c0 / q;
+	}
+
+	//normalized to x^3 + a * x^2 + b * x + c, three real roots are found trigonometrically, a single one with cardanos formula
+	void solve_cubic(double c0, double c1, double c2, double c3, double* roots)
+	{
+		const double a = c2 / c3;
+		const double b = c1 / c3;
+		const double c = c0 / c3;
+		const double Q = (a * a - 3.0 * b) / 9.0;
+		const double R = (2.0 * a * a * a - 9.0 * a * b + 27.0 * c) / 54.0;
+		const double Q_cubed = Q * Q * Q;
+		const bool three_real = R * R < Q_cubed;
+		const double shift = a / 3.0;
+
+		const double sqrt_Q = std::sqrt(std::max(Q, 0.0));
+		const double theta = std::acos(std::clamp(R / std::sqrt(std::max(Q_cubed, std::numeric_limits<double>::min())), -1.0, 1.0));
+		const double trigonometric_0 = -2.0 * sqrt_Q * std::cos(theta / 3.0) - shift;
+		const double trigonometric_1 = -2.0 * sqrt_Q * std::cos(theta / 3.0 + two_pi_thirds) - shift;
+		const double trigonometric_2 = -2.0 * sqrt_Q * std::cos(theta / 3.0 - two_pi_thirds) - shift;
+
+		const double A = -std::copysign(std::cbrt(std::abs(R) + std::sqrt(std::max(R * R - Q_cubed, 0.0))), R);
+		const double B = A != 0.0 ? Q / A : 0.0;
+		const double cardano = A + B - shift;
+
+		roots[0] = three_real ? trigonometric_0 : cardano;
+		roots[1] = three_real ? trigonometric_1 : nan;
+		roots[2] = three_real ? trigonometric_2 : nan;
+	}
+
+	//ferrari: the depressed quartic y^4 + p * y^2 + q * y + r (with x = y - a / 4) is written as difference of two squares
+	//(y^2 + p / 2 + m)^2 - (s * y - q / (2 * s))^2 with s = sqrt(2 * m), where m is the largest root of the resolvent cubic.
+	//if q is zero, m is zero as well and the quartic is solved as quadratic in y^2 instead.
+	void solve_quartic(double c0, double c1, double c2, double c3, double c4, double* roots)
+	{
+		const double a = c3 / c4;
+		const double b = c2 / c4;
+		const double c = c1 / c4;
+		const double d = c0 / c4;
+		const double a_squared = a * a;
+		const double p = b - 3.0 / 8.0 * a_squared;
+		const double q = c - a * b / 2.0 + a_squared * a / 8.0;
+		const double r = d - a * c / 4.0 + a_squared * b / 16.0 - 3.0 / 256.0 * a_squared * a_squared;
+		const double shift = a / 4.0;
+
+		std::array<double, 3> resolvent;
+		solve_cubic(-q * q / 8.0, p * p / 4.0 - r, p, 1.0, resolvent.data());
+		const double m = std::fmax(resolvent[0], std::fmax(resolvent[1], resolvent[2]));	//fmax ignores NaN
+		const bool biquadratic = !(m > 0.0);
+
+		const double s = std::sqrt(2.0 * std::max(m, 0.0));
+		std::array<double, 4> ferrari;
+		solve_quadratic(p / 2.0 + m - q / (2.0 * s), s, 1.0, ferrari.data());
+		solve_quadratic(p / 2.0 + m + q / (2.0 * s), -s, 1.0, ferrari.data() + 2);
+
+		std::array<double, 2> squares;
+		solve_quadratic(r, p, 1.0, squares.data());
+		const double y0 = std::sqrt(squares[0]);	//NaN for negative squares
+		const double y1 = std::sqrt(squares[1]);
+
+		roots[0] = (biquadratic ? y0 : ferrari[0]) - shift;
+		roots[1] = (biquadratic ? -y0 : ferrari[1]) - shift;
+		roots[2] = (biquadratic ? y1 : ferrari[2]) - shift;
+		roots[3] = (biquadratic ? -y1 : ferrari[3]) - shift;
+	}
+
+	double evaluate(const double* coefficients, int degree, double x)
+	{
+		double result = coefficients[degree];
+		for (int i = degree - 1; i >= 0; i--) {
+			result = result * x + coefficients[i];
+		}
+		return result;
+	}
+
+	//newton steps, a step is only taken if it makes |p(x)| smaller. NaN stays NaN
+	double polish(const double* coefficients, int degree, double x)
+	{
+		for (int step = 0; step < 2; step++) {
+			double value = coefficients[degree];
+			double derivative = 0.0;
+			for (int i = degree - 1; i >= 0; i--) {
+				derivative = derivative * x + value;
+				value = value * x + coefficients[i];
+			}
+			const double next = x - value / derivative;
+			x = std::abs(evaluate(coefficients, degree, next)) < std::abs(value) ? next : x;
+		}
+		return x;
+	}
+
+	void solve(int degree, const double* c, double* roots)
+	{
+		switch (degree) {
+		case 1: roots[0] = -c[0] / c[1]; break;
+		case 2: solve_quadratic(c[0], c[1], c[2], roots); break;
+		case 3: solve_cubic(c[0], c[1], c[2], c[3], roots); break;
+		case 4: solve_quartic(c[0], c[1], c[2], c[3], c[4], roots); break;
+		}
+		for (int k = 0; k < degree; k++) {
+			roots[k] = polish(c, degree, roots[k]);
+		}
+	}
+
+	void solve_batch(int degree, const double* coefficients, std::size_t count, double* roots)
+	{
+		assert(degree >= 1 && degree <= max_degree);
+		//the switch is outside of the loops, so each loop body is branch free
+		const auto for_each = [&](auto&& kernel) {
+			for (std::size_t j = 0; j < count; j++) {
+				std::array<double, max_degree + 1> c = {};
+				std::array<double, max_degree> x = {};
+				for (int i = 0; i <= degree; i++) {
+					c[i] = coefficients[i * count + j];
+				}
+				kernel(c.data(), x.data());
+				for (int k = 0; k < degree; k++) {
+					roots[k * count + j] = polish(c.data(), degree, x[k]);
+				}
+			}
+		};
+		switch (degree) {
+		case 1: for_each([](const double* c, double* x) { x[0] = -c[0] / c[1]; }); break;
+		case 2: for_each([](const double* c, double* x) { solve_quadratic(c[0], c[1], c[2], x); }); break;
+		case 3: for_each([](const double* c, double* x) { solve_cubic(c[0], c[1], c[2], c[3], x); }); break;
+		case 4: for_each([](const double* c, double* x) { solve_quartic(c[0], c[1], c[2], c[3], c[4], x); }); break;
+		}
+	}
+
+	///////////////////////////////////////////////////////////////////////////////////////////////////
+	//interval arithmetic for the certificates: every result is rounded outwards by one ulp per end,
+	//which covers the rounding to nearest of the operation, so the exact value always lies inside
+
+	constexpr double infinity = std::numeric_limits<double>::infinity();
+
+	Interval outward(double min, double max) { return Interval{ std::nextafter(min, -infinity), std::nextafter(max, infinity) }; }
+
+	Interval operator+(const Interval& a, const Interval& b) { return outward(a.min + b.min, a.max + b.max); }
+
+	Interval operator*(const Interval& a, const Interval& b)
+	{
+		const std::array<double, 4> products = { a.min * b.min, a.min * b.max, a.max * b.min, a.max * b.max };
+		const auto [min, max] = std::minmax_element(products.begin(), products.end());
+		return outward(*min, *max);
+	}
+
+	Interval point(double x) { return Interval{ x, x }; }
+
+	bool excludes_zero(const Interval& enclosure) { return enclosure.min > 0.0 || enclosure.max < 0.0; }
+
+	//contains p(x) for every x in xs, coefficients[i] belongs to x^i
+	Interval enclose(const Interval* coefficients, int degree, const Interval& xs)
+	{
+		Interval result = coefficients[degree];
+		for (int i = degree - 1; i >= 0; i--) {
+			result = result * xs + coefficients[i];
+		}
+		return result;
+	}
+
+	//the coefficients of p (exact) and p' (rounded outwards)
+	struct Enclosed_Polynomial
+	{
+		std::array<Interval, max_degree + 1> p;
+		std::array<Interval, max_degree> derivative;
+		int degree;
+
+		Enclosed_Polynomial(const double* coefficients, int degree_) :degree(degree_) {
+			for (int i = 0; i <= degree; i++) {
+				this->p[i] = point(coefficients[i]);
+			}
+			for (int i = 1; i <= degree; i++) {
+				this->derivative[i - 1] = this->p[i] * point(i);
+			}
+		}
+	};
+
+	//-1 or 1 if the sign of p(x) is certain, 0 if rounding could hide its true sign
+	int certified_sign(const Enclosed_Polynomial& p, double x)
+	{
+		const Interval value = enclose(p.p.data(), p.degree, point(x));
+		return (value.min > 0.0) - (value.max < 0.0);
+	}
+
+	//widens [root - width, root + width] until p has certainly different signs at the ends.
+	//the interval is only returned if the enclosure of p' on it excludes zero: p is strictly monotone there,
+	//so the sign change stems from exactly one simple root (and not from three)
+	std::optional<Interval> certify(const Enclosed_Polynomial& p, double root)
+	{
+		double width = std::max(std::abs(root), std::numeric_limits<double>::min()) * std::numeric_limits<double>::epsilon();
+		for (int attempt = 0; attempt < 24; attempt++) {
+			const Interval interval = { root - width, root + width };
+			if (certified_sign(p, interval.min) * certified_sign(p, interval.max) < 0) {
+				if (!excludes_zero(enclose(p.derivative.data(), p.degree - 1, interval))) {
+					return std::nullopt;
+				}
+				return interval;
+			}
+			width *= 4.0;
+		}
+		return std::nullopt;
+	}
+
+	//true if p certainly has no roots in the open interval: the bernstein coefficients, computed in interval arithmetic,
+	//are certainly nonzero and all of the same sign
+	bool root_free(const Enclosed_Polynomial& p, const Interval& interval)
+	{
+		//q(t) = p(interval.min + t * width) by horner with polynomials in t
+		const Interval min = point(interval.min);
+		const Interval width = point(interval.max) + point(-interval.min);
+		std::array<Interval, max_degree + 1> q = {};
+		q[0] = p.p[p.degree];
+		for (int i = p.degree - 1; i >= 0; i--) {
+			for (int k = p.degree - i; k >= 0; k--) {
+				q[k] = (k > 0 ? q[k - 1] * width : point(0.0)) + q[k] * min;
+			}
+			q[0] = q[0] + p.p[i];
+		}
+
+		//monomial coefficient i of t^i contributes choose(k, i) / choose(n, i) to bernstein coefficient k
+		const auto choose = [](int n, int k) {
+			double result = 1.0;
+			for (int j = 1; j <= k; j++) {
+				result = result * (n - k + j) / j;	//exact for n <= max_degree
+			}
+			return result;
+		};
+		int first_sign = 0;
+		for (int k = 0; k <= p.degree; k++) {
+			Interval bernstein = point(0.0);
+			for (int i = 0; i <= k; i++) {
+				const double ratio = choose(k, i) / choose(p.degree, i);
+				bernstein = bernstein + q[i] * outward(ratio, ratio);
+			}
+			if (!excludes_zero(bernstein)) {
+				return false;
+			}
+			const int current = bernstein.min > 0.0 ? 1 : -1;
+			if (first_sign * current < 0) {
+				return false;
+			}
+			first_sign = current;
+		}
+		return true;
+	}
+
+	std::optional<std::vector<Interval>> certified_roots(const polynomial::Monomials& p, const Interval& start_zone)
+	{
+		int degree = p.degree();
+		while (degree > 0 && p[degree] == 0.0) {
+			degree--;
+		}
+		if (degree > max_degree) {
+			return std::nullopt;
+		}
+		std::vector<Interval> result;
+		if (degree == 0) {
+			return result;	//the bernstein coefficients are all the same, descartes_root_isolation finds no sign change either
+		}
+
+		std::array<double, max_degree> roots;
+		solve(degree, p.data(), roots.data());
+		const auto real_end = std::remove_if(roots.begin(), roots.begin() + degree, [](double x) { return std::isnan(x); });
+		std::sort(roots.begin(), real_end);
+
+		const Enclosed_Polynomial enclosed(p.data(), degree);
+		std::array<Interval, max_degree> certified;
+		int certified_count = 0;
+		for (auto root = roots.begin(); root != real_end; ++root) {
+			const auto interval = certify(enclosed, *root);
+			if (!interval || (certified_count > 0 && certified[certified_count - 1].max >= interval->min)) {
+				return std::nullopt;	//not certified or overlapping with the root before
+			}
+			certified[certified_count++] = *interval;
+		}
+
+		//only intervals completely inside start_zone are reported, one sticking out is left to the subdivision
+		double gap_start = start_zone.min;
+		for (int k = 0; k < certified_count; k++) {
+			const Interval& interval = certified[k];
+			if (interval.max < start_zone.min || interval.min > start_zone.max) {
+				continue;
+			}
+			if (interval.min < start_zone.min || interval.max > start_zone.max) {
+				return std::nullopt;
+			}
+			if (certified_count < degree && !root_free(enclosed, Interval{ gap_start, interval.min })) {
+				return std::nullopt;
+			}
+			gap_start = interval.max;
+			result.push_back(interval);
+		}
+		if (certified_count < degree && !root_free(enclosed, Interval{ gap_start, start_zone.max })) {
+			return std::nullopt;
+		}
+		if (certified_sign(enclosed, start_zone.min) == 0 || certified_sign(enclosed, start_zone.max) == 0) {
+			return std::nullopt;
+		}
+
+		std::reverse(result.begin(), result.end());	//same order as descartes_root_isolation (upper half first)
+		return result;
+	}
+
+} //namespace low_degree
@@ -0,0 +1,37 @@
+#pragma once
+
+#include <vector>
+#include <optional>
+
+#include "descartes.hpp"
+
+//closed form solutions for polynomials of degree at most 4.
+//the kernels contain no data dependent branches (all case distinctions are selects),
+//so a loop over many polynomials of the same degree can be vectorized by the compiler.
+//roots which are not real (or do not exist for the given coefficients) are returned as NaN.
+namespace low_degree {
+
+	constexpr int max_degree = 4;
+
+	//c2 * x^2 + c1 * x + c0, writes 2 roots
+	void solve_quadratic(double c0, double c1, double c2, double* roots);
+
+	//c3 * x^3 + c2 * x^2 + c1 * x + c0, writes 3 roots
+	void solve_cubic(double c0, double c1, double c2, double c3, double* roots);
+
+	//c4 * x^4 + ... + c0, writes 4 roots
+	void solve_quartic(double c0, double c1, double c2, double c3, double c4, double* roots);
+
+	//solves count polynomials of the same degree (1 to 4) stored as structure of arrays:
+	//coefficients[i * count + j] belongs to x^i of polynomial j, roots[k * count + j] is root k of polynomial j.
+	//the roots of one polynomial are in no particular order, each gets a few newton steps to polish it.
+	void solve_batch(int degree, const double* coefficients, std::size_t count, double* roots);
+
+	//isolating intervals of all roots of p in start_zone computed from the closed forms, each a few ulp wide around the root.
+	//all certificates are evaluated in interval arithmetic: p has a certain sign change at the ends of every interval
+	//and p' certainly no root inside, so each holds exactly one simple root. that no root is missing is certified
+	//by the count (degree many intervals) or by bernstein coefficients of a single certain sign in the gaps.
+	//returns std::nullopt if p has a degree above 4 or anything could not be certified (e.g. a multiple root).
+	std::optional<std::vector<Interval>> certified_roots(const polynomial::Monomials& p, const Interval& start_zone);
+
+} //namespace low_degree
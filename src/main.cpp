@@ -2,12 +2,54 @@
 #include <vector>
 #include <chrono>
 #include <cstdlib>
+#include <algorithm>
+#include <cmath>
 
 #include "descartes.hpp"
+#include "anytime.hpp"
+#include "bitstream.hpp"
+#include "cache.hpp"
+#include "descartes_c.h"
+#include "exact.hpp"
 #include "graph.hpp"
+#include "service.hpp"
 
 using namespace polynomial;
 
+//behaviour checks print what went wrong, main fails if any of them did
+namespace checks {
+
+	int failures = 0;
+
+	void expect(bool condition, const char* what)
+	{
+		if (!condition) {
+			std::cout << "\n  FAILED: " << what;
+			failures++;
+		}
+	}
+
+	//every root lies in exactly one of the intervals
+	bool each_in_one(const std::vector<double>& roots, const std::vector<Interval>& intervals)
+	{
+		for (const double root : roots) {
+			const auto containing = std::count_if(intervals.begin(), intervals.end(),
+				[root](const Interval& i) { return i.min <= root && root <= i.max; });
+			if (containing != 1) {
+				return false;
+			}
+		}
+		return true;
+	}
+
+	bool same(const std::vector<Interval>& a, const std::vector<Interval>& b)
+	{
+		return a.size() == b.size() && std::equal(a.begin(), a.end(), b.begin(),
+			[](const Interval& i, const Interval& j) { return i.min == j.min && i.max == j.max; });
+	}
+
+} //namespace checks
+
 int main()
 {
 
@@ -86,4 +128,219 @@ int main()
 		plot.add_polynomial(bernstein, svg_style::line(rgb::navy, 0.5));
 		std::cout << "  done\n";
 	}
+
+	{
+		std::cout << "subdivision trace test...";
+		const Monomials p = from_roots({ -3.1, -3, 0.5, 0.55, 2 }) * 0.1;
+		Subdivision_Trace trace;
+		auto root_intervals = descartes_root_isolation(p, Interval{ -5, 5 }, default_accept, &trace);
+		trace.write_chrome_trace("svg/subdivision_trace.json");
+
+		Plot plot("svg/subdivision_trace.svg", 5, 5);
+		plot.add_polynomial(p, svg_style::line(rgb::salmon, 0.5));
+		plot.add_subdivision_trace(trace);
+		for (const auto& interval : root_intervals) {
+			plot.add_interval(interval);
+		}
+		std::cout << "  done\n";
+	}
+
+	{
+		std::cout << "c interface test...";
+		std::vector<double> roots;
+		for (int i = 1; i <= 20; i++) {
+			roots.push_back(i * 0.1);
+		}
+		const Monomials p = from_roots(roots);
+		descartes_workspace* const workspace = descartes_workspace_create(0);	//has to grow while isolating
+		std::vector<double> buffer(2 * roots.size());
+		std::size_t found = 0;
+		checks::expect(descartes_isolate(workspace, p.data(), p.size(), 0.05, 2.05, 0.000001, nullptr, 0, &found) == DESCARTES_BUFFER_TOO_SMALL,
+			"descartes_isolate reports a buffer of capacity 0 as too small");
+		checks::expect(found == roots.size(), "descartes_isolate counts all roots without a buffer");
+		const descartes_status status = descartes_isolate(workspace, p.data(), p.size(), 0.05, 2.05, 0.000001, buffer.data(), roots.size(), &found);
+		std::vector<Interval> intervals;
+		for (std::size_t i = 0; i < found && i < roots.size(); i++) {
+			intervals.push_back(Interval{ buffer[2 * i], buffer[2 * i + 1] });
+		}
+		checks::expect(status == DESCARTES_OK && found == roots.size(), "descartes_isolate finds all 20 roots");
+		checks::expect(checks::each_in_one(roots, intervals), "descartes_isolate separates all roots");
+		descartes_workspace_destroy(workspace);
+		std::cout << "  done\n";
+	}
+
+	{
+		std::cout << "exact roots test...";
+		std::vector<multiprecision::Big_Int> wilkinson = { 1 };	//(x - 1) * (x - 2) * ... * (x - 20)
+		std::vector<double> roots;
+		for (std::int64_t k = 1; k <= 20; k++) {
+			std::vector<multiprecision::Big_Int> next(wilkinson.size() + 1, 0);
+			for (std::size_t i = 0; i < wilkinson.size(); i++) {
+				next[i + 1] += wilkinson[i];
+				next[i] -= wilkinson[i] * k;
+			}
+			wilkinson = std::move(next);
+			roots.push_back(k);
+		}
+		const std::vector<Dyadic_Interval> found = exact_root_isolation(wilkinson);
+		//isolating intervals are open, roots hit exactly are points
+		const auto contains = [](const Dyadic_Interval& i, double root) {
+			const Interval bounds = i.to_interval();
+			return i.is_point() ? bounds.min == root : bounds.min < root && root < bounds.max;
+		};
+		checks::expect(found.size() == 20 && std::all_of(found.begin(), found.end(), [](const Dyadic_Interval& i) { return i.roots == 1; }),
+			"exact_root_isolation isolates all 20 roots of wilkinsons polynomial");
+		checks::expect(std::all_of(roots.begin(), roots.end(), [&](double root) {
+				return std::count_if(found.begin(), found.end(), [&](const Dyadic_Interval& i) { return contains(i, root); }) == 1; }),
+			"exact_root_isolation separates the roots of wilkinsons polynomial");
+
+		const std::vector<std::int64_t> double_root = { 2, -3, 0, 1 };	//(x - 1)^2 * (x + 2)
+		const std::vector<Dyadic_Interval> found_double = exact_root_isolation(double_root);
+		const auto holds = [&found_double](double root, std::size_t multiplicity) {
+			return std::any_of(found_double.begin(), found_double.end(), [=](const Dyadic_Interval& i) {
+				const Interval bounds = i.to_interval();
+				return bounds.min <= root && root <= bounds.max && i.roots == multiplicity;	//closed, the double root may also be given up at max_depth
+			});
+		};
+		checks::expect(found_double.size() == 2 && holds(1.0, 2) && holds(-2.0, 1), "exact_root_isolation reports the double root with multiplicity 2");
+		std::cout << "  done\n";
+	}
+
+	{
+		std::cout << "anytime roots test...";
+		std::vector<double> roots;
+		for (int i = 1; i <= 20; i++) {
+			roots.push_back(i * 0.1);
+		}
+		const Monomials p = from_roots(roots);
+		const Interval zone = { 0.0, 2.1 };	//no root is a split point
+
+		Anytime_Settings settings;
+		settings.max_nodes = 8;
+		const Anytime_Result cut = anytime_root_isolation(p, zone, settings);
+		std::vector<Interval> covering = cut.roots;
+		for (const Frontier_Leaf& leaf : cut.unresolved) {
+			if (leaf.roots > 0) {
+				covering.push_back(leaf.interval);
+			}
+		}
+		checks::expect(cut.reason == Stop_Reason::node_budget && cut.nodes <= settings.max_nodes, "anytime_root_isolation stops at its node budget");
+		checks::expect(cut.roots.size() < roots.size(), "anytime_root_isolation has not finished within 8 nodes");
+		checks::expect(checks::each_in_one(roots, covering), "anytime_root_isolation covers every root after being stopped");
+
+		const Anytime_Result full = anytime_root_isolation(p, zone);
+		checks::expect(full.reason == Stop_Reason::finished && full.roots.size() == roots.size() && checks::each_in_one(roots, full.roots),
+			"anytime_root_isolation without limits isolates all roots");
+		std::cout << "  done\n";
+	}
+
+	{
+		std::cout << "isolation cache test...";
+		const Monomials p = from_roots({ -0.7, 0.2, 0.25, 0.9 });
+		const Interval zone = { -1.0, 1.0 };
+		Isolation_Cache cache;
+		const std::vector<Interval> first = cache.root_isolation(p, zone);
+		const std::vector<Interval> scaled = cache.root_isolation(p * 4.0, zone);
+		const Cache_Statistics after_scaled = cache.statistics();
+		checks::expect(after_scaled.misses == 1 && after_scaled.hits == 1 && after_scaled.size == 1, "isolation cache hits for a scalar multiple");
+		checks::expect(checks::same(first, scaled), "isolation cache returns the stored intervals");
+		checks::expect(checks::same(first, descartes_root_isolation(p, zone)) && first.size() == 4, "isolation cache stores what descartes_root_isolation finds");
+
+		cache.root_isolation(p, Interval{ 0.0, 1.0 });
+		checks::expect(cache.statistics().misses == 2, "isolation cache misses for another start zone");
+		std::cout << "  done\n";
+	}
+
+	{
+		std::cout << "level set test...";
+		const Monomials p = from_roots({ -0.8, -0.3, 0.1, 0.6, 0.9 });
+		const Interval zone = { -1.0, 1.0 };
+		const std::vector<double> levels = { -0.05, 0.0, 0.02, 0.3 };
+		const std::vector<std::vector<Interval>> level_sets = level_set_isolation(p, zone, levels);
+		checks::expect(level_sets.size() == levels.size() && level_sets[1].size() == 5, "level_set_isolation finds all roots of p at level 0");
+		for (std::size_t i = 0; i < levels.size() && i < level_sets.size(); i++) {
+			Monomials shifted = p;
+			shifted[0] -= levels[i];
+			std::vector<Interval> direct = descartes_root_isolation(to_bernstein(shifted, zone));
+			std::vector<Interval> shared = level_sets[i];
+			const auto by_min = [](const Interval& a, const Interval& b) { return a.min < b.min; };
+			std::sort(direct.begin(), direct.end(), by_min);
+			std::sort(shared.begin(), shared.end(), by_min);
+			//both isolate the same roots, the intervals may differ by rounding of the shifted coefficients
+			checks::expect(direct.size() == shared.size() && std::equal(direct.begin(), direct.end(), shared.begin(),
+					[](const Interval& a, const Interval& b) { return a.min <= b.max && b.min <= a.max; }),
+				"level_set_isolation finds the same roots as isolating p - level directly");
+		}
+		std::cout << "  done\n";
+	}
+
+	{
+		std::cout << "bitstream roots test...";
+		checks::expect(checks::each_in_one({ -0.45, 0.3, 0.7 }, bitstream_root_isolation(from_roots({ -0.45, 0.3, 0.7 }), Interval{ -1.0, 1.0 })),
+			"bitstream_root_isolation isolates the roots of a polynomial with double coefficients");
+
+		//roots 1 and 1 + 2^-60 can not be told apart with doubles
+		using multiprecision::Big_Float;
+		const std::vector<Big_Float> roots = { Big_Float(1.0), Big_Float(1.0) + Big_Float(multiprecision::Big_Int(1), -60), Big_Float(-0.75) };
+		std::vector<Big_Float> coefficients = { Big_Float(1.0) };
+		for (const Big_Float& root : roots) {
+			std::vector<Big_Float> next(coefficients.size() + 1, Big_Float());
+			for (std::size_t i = 0; i < coefficients.size(); i++) {
+				next[i + 1] = next[i + 1] + coefficients[i];
+				next[i] = next[i] - root * coefficients[i];
+			}
+			coefficients = std::move(next);
+		}
+		const Bitstream_Polynomial close_roots = { coefficients.size() - 1,
+			[coefficients](std::size_t i, std::size_t) { return coefficients[i]; }, true };
+		const std::vector<Interval> found = bitstream_root_isolation(close_roots, Interval{ -2.0, 2.0 });
+		const auto near_one = std::count_if(found.begin(), found.end(), [](const Interval& i) { return i.min >= 1.0 - 1e-15 && i.max <= 1.0 + 1e-15; });
+		checks::expect(found.size() == 3 && near_one == 2 && checks::each_in_one({ -0.75 }, found),
+			"bitstream_root_isolation separates roots closer than double precision");
+
+		//the root of x - 1/3 lies just left of the zone, 16 bits can not decide whether the zone holds it
+		Isolation_Frontier uncertain;
+		const std::vector<Interval> certified = bitstream_root_isolation(to_bitstream(Monomials{ -1.0 / 3.0, 1.0 }),
+			Interval{ 1.0 / 3.0 + 1e-9, 1.0 }, 16, 16, &uncertain);
+		checks::expect(certified.empty() && uncertain.size() == 1 && uncertain[0].roots == 1,
+			"bitstream_root_isolation keeps undecided nodes out of its result");
+		std::cout << "  done\n";
+	}
+
+	{
+		std::cout << "isolation service test...";
+		Isolation_Service::Settings settings;
+		settings.socket_path = "descartes_check.sock";
+		settings.threads = 2;
+		Isolation_Service service(settings);
+		Service_Client client(settings.socket_path);
+
+		std::vector<double> roots;
+		for (int i = 1; i <= 20; i++) {
+			roots.push_back(i * 0.1);
+		}
+		checks::expect(checks::each_in_one(roots, client.isolate(from_roots(roots), Interval{ 0.0, 2.1 })),
+			"isolation service isolates a polynomial of degree 20");
+
+		Monomials high_degree(71, 0.0);	//x^70 - 0.5, too high for a cached plan
+		high_degree[0] = -0.5;
+		high_degree[70] = 1.0;
+		checks::expect(checks::each_in_one({ std::pow(0.5, 1.0 / 70.0) }, client.isolate(high_degree, Interval{ 0.5, 1.5 })),
+			"isolation service isolates a polynomial above max_plan_degree");
+
+		bool rejected = false;
+		try {
+			client.isolate(Monomials(wire::max_coefficient_count + 1, 1.0), Interval{ 0.0, 1.0 });
+		}
+		catch (const std::exception&) {
+			rejected = true;
+		}
+		checks::expect(rejected, "isolation service rejects too many coefficients");
+		checks::expect(client.isolate(from_roots({ 0.5 }), Interval{ 0.0, 1.0 }).size() == 1, "isolation service answers after a rejected request");
+		checks::expect(client.statistics().requests >= 3, "isolation service counts the requests");
+		service.stop();
+		std::cout << "  done\n";
+	}
+
+	return checks::failures == 0 ? EXIT_SUCCESS : EXIT_FAILURE;
 }
\ No newline at end of file
@@ -0,0 +1,472 @@
+#include "multiprecision.hpp"
+
+#include <cmath>
+#include <cassert>
+#include <algorithm>
+
+namespace multiprecision {
+
+	namespace magnitude_arithmetic {
+
+		using Limbs = std::vector<std::uint32_t>;
+
+		int compare(const Limbs& a, const Limbs& b)
+		{
+			if (a.size() != b.size()) {
+				return a.size() < b.size() ? -1 : 1;
+			}
+			for (std::size_t i = a.size(); i > 0; i--) {
+				if (a[i - 1] != b[i - 1]) {
+					return a[i - 1] < b[i - 1] ? -1 : 1;
+				}
+			}
+			return 0;
+		}
+
+		Limbs add(const Limbs& a, const Limbs& b)
+		{
+			const Limbs& longer = a.size() >= b.size() ? a : b;
+			const Limbs& shorter = a.size() >= b.size() ? b : a;
+
+			Limbs result;
+			result.reserve(longer.size() + 1);
+			std::uint64_t carry = 0;
+			for (std::size_t i = 0; i < longer.size(); i++) {
+				const std::uint64_t sum = carry + longer[i] + (i < shorter.size() ? shorter[i] : 0u);
+				result.push_back(static_cast<std::uint32_t>(sum));
+				carry = sum >> 32;
+			}
+			if (carry) {
+				result.push_back(static_cast<std::uint32_t>(carry));
+			}
+			return result;
+		}
+
+		//assumes a >= b
+		Limbs subtract(const Limbs& a, const Limbs& b)
+		{
+			assert(compare(a, b) >= 0);
+			Limbs result;
+			result.reserve(a.size());
+			std::int64_t borrow = 0;
+			for (std::size_t i = 0; i < a.size(); i++) {
+				std::int64_t difference = static_cast<std::int64_t>(a[i]) - borrow - (i < b.size() ? b[i] : 0u);
+				borrow = 0;
+				if (difference < 0) {
+					difference += std::int64_t(1) << 32;
+					borrow = 1;
+				}
+				result.push_back(static_cast<std::uint32_t>(difference));
+			}
+			return result;
+		}
+
+		Limbs multiply(const Limbs& a, const Limbs& b)
+		{
+			if (a.empty() || b.empty()) {
+				return {};
+			}
+			Limbs result(a.size() + b.size(), 0u);
+			for (std::size_t i = 0; i < a.size(); i++) {
+				std::uint64_t carry = 0;
+				for (std::size_t j = 0; j < b.size(); j++) {
+					const std::uint64_t product = static_cast<std::uint64_t>(a[i]) * b[j] + result[i + j] + carry;
+					result[i + j] = static_cast<std::uint32_t>(product);
+					carry = product >> 32;
+				}
+				result[i + b.size()] = static_cast<std::uint32_t>(carry);
+			}
+			return result;
+		}
+
+		//divides a in place by divisor, returns remainder
+		std::uint32_t divide_in_place(Limbs& a, std::uint32_t divisor)
+		{
+			std::uint64_t remainder = 0;
+			for (std::size_t i = a.size(); i > 0; i--) {
+				const std::uint64_t current = (remainder << 32) | a[i - 1];
+				a[i - 1] = static_cast<std::uint32_t>(current / divisor);
+				remainder = current % divisor;
+			}
+			while (a.size() && a.back() == 0) {
+				a.pop_back();
+			}
+			return static_cast<std::uint32_t>(remainder);
+		}
+
+	} //namespace magnitude_arithmetic
+
+	void Big_Int::trim()
+	{
+		while (this->magnitude.size() && this->magnitude.back() == 0) {
+			this->magnitude.pop_back();
+		}
+		if (this->magnitude.empty()) {
+			this->negative = false;
+		}
+	}
+
+	Big_Int::Big_Int(std::int64_t value)
+		:negative(value < 0)
+	{
+		//written this way to not overflow for the smallest int64
+		std::uint64_t absolute = value < 0 ? ~static_cast<std::uint64_t>(value) + 1 : static_cast<std::uint64_t>(value);
+		while (absolute) {
+			this->magnitude.push_back(static_cast<std::uint32_t>(absolute));
+			absolute >>= 32;
+		}
+	}
+
+	std::size_t Big_Int::bit_length() const
+	{
+		if (this->magnitude.empty()) {
+			return 0;
+		}
+		std::size_t result = (this->magnitude.size() - 1) * 32;
+		for (std::uint32_t top = this->magnitude.back(); top; top >>= 1) {
+			result++;
+		}
+		return result;
+	}
+
+	bool Big_Int::any_bit_below(std::size_t count) const
+	{
+		const std::size_t full_limbs = std::min(count / 32, this->magnitude.size());
+		for (std::size_t i = 0; i < full_limbs; i++) {
+			if (this->magnitude[i]) {
+				return true;
+			}
+		}
+		const std::size_t rest_bits = count % 32;
+		if (rest_bits && full_limbs < this->magnitude.size()) {
+			return (this->magnitude[full_limbs] & ((std::uint32_t(1) << rest_bits) - 1)) != 0;
+		}
+		return false;
+	}
+
+	std::size_t Big_Int::trailing_zeros() const
+	{
+		std::size_t result = 0;
+		for (const std::uint32_t limb : this->magnitude) {
+			if (limb) {
+				for (std::uint32_t rest = limb; !(rest & 1u); rest >>= 1) {
+					result++;
+				}
+				return result;
+			}
+			result += 32;
+		}
+		return 0;
+	}
+
+	Big_Int Big_Int::abs() const
+	{
+		Big_Int result = *this;
+		result.negative = false;
+		return result;
+	}
+
+	Big_Int Big_Int::operator-() const
+	{
+		Big_Int result = *this;
+		result.negative = !result.negative;
+		result.trim();
+		return result;
+	}
+
+	Big_Int Big_Int::operator<<(std::size_t shift) const
+	{
+		if (this->is_zero()) {
+			return *this;
+		}
+		const std::size_t limb_shift = shift / 32;
+		const std::size_t bit_shift = shift % 32;
+
+		Big_Int result;
+		result.negative = this->negative;
+		result.magnitude.assign(limb_shift, 0u);
+		result.magnitude.reserve(limb_shift + this->magnitude.size() + 1);
+		std::uint32_t carry = 0;
+		for (const std::uint32_t limb : this->magnitude) {
+			result.magnitude.push_back(bit_shift ? (limb << bit_shift) | carry : limb);
+			carry = bit_shift ? limb >> (32 - bit_shift) : 0u;
+		}
+		if (carry) {
+			result.magnitude.push_back(carry);
+		}
+		return result;
+	}
+
+	Big_Int Big_Int::operator>>(std::size_t shift) const
+	{
+		const std::size_t limb_shift = shift / 32;
+		const std::size_t bit_shift = shift % 32;
+		if (limb_shift >= this->magnitude.size()) {
+			return Big_Int();
+		}
+
+		Big_Int result;
+		result.negative = this->negative;
+		result.magnitude.reserve(this->magnitude.size() - limb_shift);
+		for (std::size_t i = limb_shift; i < this->magnitude.size(); i++) {
+			const std::uint32_t upper = i + 1 < this->magnitude.size() ? this->magnitude[i + 1] : 0u;
+			result.magnitude.push_back(bit_shift ? (this->magnitude[i] >> bit_shift) | (upper << (32 - bit_shift)) : this->magnitude[i]);
+		}
+		result.trim();
+		return result;
+	}
+
+	Big_Int& Big_Int::operator+=(const Big_Int& other)
+	{
+		*this = *this + other;
+		return *this;
+	}
+
+	Big_Int& Big_Int::operator-=(const Big_Int& other)
+	{
+		*this = *this - other;
+		return *this;
+	}
+
+	Big_Int operator+(const Big_Int& a, const Big_Int& b)
+	{
+		using namespace magnitude_arithmetic;
+		Big_Int result;
+		if (a.negative == b.negative) {
+			result.magnitude = add(a.magnitude, b.magnitude);
+			result.negative = a.negative;
+		}
+		else if (compare(a.magnitude, b.magnitude) >= 0) {
+			result.magnitude = subtract(a.magnitude, b.magnitude);
+			result.negative = a.negative;
+		}
+		else {
+			result.magnitude = subtract(b.magnitude, a.magnitude);
+			result.negative = b.negative;
+		}
+		result.trim();
+		return result;
+	}
+
+	Big_Int operator-(const Big_Int& a, const Big_Int& b)
+	{
+		return a + (-b);
+	}
+
+	Big_Int operator*(const Big_Int& a, const Big_Int& b)
+	{
+		Big_Int result;
+		result.magnitude = magnitude_arithmetic::multiply(a.magnitude, b.magnitude);
+		result.negative = a.negative != b.negative;
+		result.trim();
+		return result;
+	}
+
+	int compare_magnitude(const Big_Int& a, const Big_Int& b)
+	{
+		return magnitude_arithmetic::compare(a.magnitude, b.magnitude);
+	}
+
+	int compare(const Big_Int& a, const Big_Int& b)
+	{
+		if (a.sign() != b.sign()) {
+			return a.sign() < b.sign() ? -1 : 1;
+		}
+		const int magnitude_order = compare_magnitude(a, b);
+		return a.negative ? -magnitude_order : magnitude_order;
+	}
+
+	bool Big_Int::to_int64(std::int64_t& result) const
+	{
+		if (this->bit_length() > 63) {
+			return false;
+		}
+		std::uint64_t absolute = 0;
+		for (std::size_t i = this->magnitude.size(); i > 0; i--) {
+			absolute = (absolute << 32) | this->magnitude[i - 1];
+		}
+		result = this->negative ? -static_cast<std::int64_t>(absolute) : static_cast<std::int64_t>(absolute);
+		return true;
+	}
+
+	double Big_Int::to_double() const
+	{
+		//only the highest 64 bits matter for a double
+		const std::size_t length = this->bit_length();
+		const std::size_t dropped = length > 64 ? length - 64 : 0;
+		const Big_Int top = *this >> dropped;
+		std::uint64_t absolute = 0;
+		for (std::size_t i = top.magnitude.size(); i > 0; i--) {
+			absolute = (absolute << 32) | top.magnitude[i - 1];
+		}
+		const double result = std::ldexp(static_cast<double>(absolute), static_cast<int>(dropped));
+		return this->negative ? -result : result;
+	}
+
+	std::string Big_Int::to_string() const
+	{
+		if (this->is_zero()) {
+			return "0";
+		}
+		std::vector<std::uint32_t> rest = this->magnitude;
+		std::string reversed_digits;
+		while (rest.size()) {
+			std::uint32_t chunk = magnitude_arithmetic::divide_in_place(rest, 1000000000u);
+			for (int i = 0; i < 9 && (rest.size() || chunk); i++) {
+				reversed_digits.push_back(static_cast<char>('0' + chunk % 10));
+				chunk /= 10;
+			}
+		}
+		if (this->negative) {
+			reversed_digits.push_back('-');
+		}
+		return std::string(reversed_digits.rbegin(), reversed_digits.rend());
+	}
+
+	std::ostream& operator<<(std::ostream& stream, const Big_Int& value)
+	{
+		return stream << value.to_string();
+	}
+
+	///////////////////////////////////////////////////////////////////////////////////////////////////
+
+	void Big_Float::canonicalize()
+	{
+		if (this->mantissa.is_zero()) {
+			this->exponent = 0;
+		}
+		else {
+			const std::size_t zeros = this->mantissa.trailing_zeros();
+			this->mantissa = this->mantissa >> zeros;
+			this->exponent += zeros;
+		}
+	}
+
+	Big_Float::Big_Float(Big_Int mantissa_, std::int64_t exponent_)
+		:mantissa(std::move(mantissa_)), exponent(exponent_)
+	{
+		this->canonicalize();
+	}
+
+	Big_Float::Big_Float(double value)
+	{
+		assert(std::isfinite(value));
+		int binary_exponent = 0;
+		const double fraction = std::frexp(value, &binary_exponent);	//value = fraction * 2^binary_exponent with |fraction| in [0.5, 1)
+		this->mantissa = Big_Int(static_cast<std::int64_t>(std::ldexp(fraction, 53)));
+		this->exponent = binary_exponent - 53;
+		this->canonicalize();
+	}
+
+	std::int64_t Big_Float::most_significant_bit() const
+	{
+		return this->exponent + static_cast<std::int64_t>(this->mantissa.bit_length()) - 1;
+	}
+
+	Big_Float Big_Float::operator-() const
+	{
+		return Big_Float(-this->mantissa, this->exponent);
+	}
+
+	Big_Float Big_Float::abs() const
+	{
+		return Big_Float(this->mantissa.abs(), this->exponent);
+	}
+
+	Big_Float Big_Float::scaled(std::int64_t power) const
+	{
+		Big_Float result = *this;
+		if (!result.is_zero()) {
+			result.exponent += power;
+		}
+		return result;
+	}
+
+	double Big_Float::to_double(Rounding rounding) const
+	{
+		const Big_Float rounded = round(*this, 53, rounding);
+		std::int64_t small_mantissa = 0;
+		const bool fits = rounded.mantissa.to_int64(small_mantissa);
+		assert(fits); (void)fits;
+
+		const std::int64_t max_exponent = 2048;
+		if (rounded.exponent > max_exponent) {
+			return small_mantissa > 0 ? HUGE_VAL : -HUGE_VAL;
+		}
+		if (rounded.exponent < -max_exponent) {
+			if (rounding == Rounding::up && small_mantissa > 0) { return std::nextafter(0.0, 1.0); }
+			if (rounding == Rounding::down && small_mantissa < 0) { return std::nextafter(0.0, -1.0); }
+			return 0.0;
+		}
+		return std::ldexp(static_cast<double>(small_mantissa), static_cast<int>(rounded.exponent));
+	}
+
+	Big_Float round(const Big_Float& x, std::size_t precision, Rounding rounding)
+	{
+		const std::size_t length = x.mantissa.bit_length();
+		if (precision == exact || length <= precision) {
+			return x;
+		}
+		const std::size_t dropped = length - precision;
+		Big_Int kept = x.mantissa >> dropped;	//truncated towards zero
+
+		if (x.mantissa.any_bit_below(dropped)) {
+			bool away_from_zero = false;
+			switch (rounding) {
+			case Rounding::down:    away_from_zero = x.sign() < 0; break;
+			case Rounding::up:      away_from_zero = x.sign() > 0; break;
+			case Rounding::nearest: away_from_zero = (x.mantissa.abs() >> (dropped - 1)).any_bit_below(1); break;
+			}
+			if (away_from_zero) {
+				kept += Big_Int(x.sign());
+			}
+		}
+		return Big_Float(std::move(kept), x.exponent + static_cast<std::int64_t>(dropped));
+	}
+
+	Big_Float add(const Big_Float& a, const Big_Float& b, std::size_t precision, Rounding rounding)
+	{
+		if (a.is_zero()) { return round(b, precision, rounding); }
+		if (b.is_zero()) { return round(a, precision, rounding); }
+
+		const bool a_lower = a.exponent <= b.exponent;
+		const Big_Float& lower = a_lower ? a : b;
+		const Big_Float& higher = a_lower ? b : a;
+		const Big_Int sum = lower.mantissa + (higher.mantissa << static_cast<std::size_t>(higher.exponent - lower.exponent));
+		return round(Big_Float(sum, lower.exponent), precision, rounding);
+	}
+
+	Big_Float multiply(const Big_Float& a, const Big_Float& b, std::size_t precision, Rounding rounding)
+	{
+		return round(Big_Float(a.mantissa * b.mantissa, a.exponent + b.exponent), precision, rounding);
+	}
+
+	int compare(const Big_Float& a, const Big_Float& b)
+	{
+		if (a.sign() != b.sign()) {
+			return a.sign() < b.sign() ? -1 : 1;
+		}
+		return (a - b).sign();
+	}
+
+	Big_Float operator+(const Big_Float& a, const Big_Float& b)
+	{
+		return add(a, b, exact, Rounding::nearest);
+	}
+
+	Big_Float operator-(const Big_Float& a, const Big_Float& b)
+	{
+		return add(a, -b, exact, Rounding::nearest);
+	}
+
+	Big_Float operator*(const Big_Float& a, const Big_Float& b)
+	{
+		return multiply(a, b, exact, Rounding::nearest);
+	}
+
+	std::ostream& operator<<(std::ostream& stream, const Big_Float& value)
+	{
+		return stream << value.to_double();
+	}
+
+} //namespace multiprecision
@@ -0,0 +1,128 @@
+#pragma once
+
+#include <vector>
+#include <cstdint>
+#include <string>
+#include <iostream>
+
+namespace multiprecision {
+
+	//signed integer of arbitrary size
+	//magnitude is stored little endian in base 2^32 without leading zero limbs (zero is the empty vector)
+	class Big_Int
+	{
+	private:
+		std::vector<std::uint32_t> magnitude;
+		bool negative = false;
+
+		void trim();
+
+	public:
+		Big_Int() = default;
+		Big_Int(std::int64_t value);
+
+		int sign() const { return this->magnitude.empty() ? 0 : (this->negative ? -1 : 1); }
+		bool is_zero() const { return this->magnitude.empty(); }
+
+		//number of bits needed to store the absolute value (0 for zero)
+		std::size_t bit_length() const;
+		//true if any of the lowest count bits of the absolute value is set
+		bool any_bit_below(std::size_t count) const;
+		std::size_t trailing_zeros() const;
+
+		Big_Int abs() const;
+		Big_Int operator-() const;
+
+		//shifts work on the absolute value, the sign stays (>> truncates towards zero)
+		Big_Int operator<<(std::size_t shift) const;
+		Big_Int operator>>(std::size_t shift) const;
+
+		Big_Int& operator+=(const Big_Int& other);
+		Big_Int& operator-=(const Big_Int& other);
+
+		friend Big_Int operator+(const Big_Int& a, const Big_Int& b);
+		friend Big_Int operator-(const Big_Int& a, const Big_Int& b);
+		friend Big_Int operator*(const Big_Int& a, const Big_Int& b);
+
+		friend int compare(const Big_Int& a, const Big_Int& b);
+		friend int compare_magnitude(const Big_Int& a, const Big_Int& b);
+
+		//true if value fits into std::int64_t, the value is then written to result
+		bool to_int64(std::int64_t& result) const;
+		double to_double() const;
+		std::string to_string() const;
+	};
+
+	int compare(const Big_Int& a, const Big_Int& b);
+	int compare_magnitude(const Big_Int& a, const Big_Int& b);
+
+	inline bool operator==(const Big_Int& a, const Big_Int& b) { return compare(a, b) == 0; }
+	inline bool operator<(const Big_Int& a, const Big_Int& b) { return compare(a, b) < 0; }
+
+	std::ostream& operator<<(std::ostream& stream, const Big_Int& value);
+
+
+	enum class Rounding
+	{
+		down,	//towards -infinity
+		up,		//towards +infinity
+		nearest,
+	};
+
+	//precision 0 means exact (no rounding at all)
+	constexpr std::size_t exact = 0;
+
+	//binary floating point number with arbitrary precision: value = mantissa * 2^exponent
+	//the mantissa is kept odd (or zero), so every value has exactly one representation
+	class Big_Float
+	{
+	private:
+		Big_Int mantissa;
+		std::int64_t exponent = 0;
+
+		void canonicalize();
+
+	public:
+		Big_Float() = default;
+		Big_Float(Big_Int mantissa_, std::int64_t exponent_);
+		Big_Float(double value);	//exact, as every finite double is a dyadic number
+
+		int sign() const { return this->mantissa.sign(); }
+		bool is_zero() const { return this->mantissa.is_zero(); }
+		const Big_Int& get_mantissa() const { return this->mantissa; }
+		std::int64_t get_exponent() const { return this->exponent; }
+
+		//exponent of the highest set bit, value lies in [2^(msb), 2^(msb + 1)) in absolute terms
+		std::int64_t most_significant_bit() const;
+
+		Big_Float operator-() const;
+		Big_Float abs() const;
+		//multiplies with 2^power, always exact
+		Big_Float scaled(std::int64_t power) const;
+
+		double to_double(Rounding rounding = Rounding::nearest) const;
+
+		friend Big_Float round(const Big_Float& x, std::size_t precision, Rounding rounding);
+		friend Big_Float add(const Big_Float& a, const Big_Float& b, std::size_t precision, Rounding rounding);
+		friend Big_Float multiply(const Big_Float& a, const Big_Float& b, std::size_t precision, Rounding rounding);
+		friend int compare(const Big_Float& a, const Big_Float& b);
+	};
+
+	//rounded arithmetic, result has at most precision bits of mantissa
+	Big_Float round(const Big_Float& x, std::size_t precision, Rounding rounding);
+	Big_Float add(const Big_Float& a, const Big_Float& b, std::size_t precision, Rounding rounding);
+	Big_Float multiply(const Big_Float& a, const Big_Float& b, std::size_t precision, Rounding rounding);
+	int compare(const Big_Float& a, const Big_Float& b);
+
+	//exact arithmetic
+	Big_Float operator+(const Big_Float& a, const Big_Float& b);
+	Big_Float operator-(const Big_Float& a, const Big_Float& b);
+	Big_Float operator*(const Big_Float& a, const Big_Float& b);
+
+	inline bool operator==(const Big_Float& a, const Big_Float& b) { return compare(a, b) == 0; }
+	inline bool operator<(const Big_Float& a, const Big_Float& b) { return compare(a, b) < 0; }
+	inline bool operator<=(const Big_Float& a, const Big_Float& b) { return compare(a, b) <= 0; }
+
+	std::ostream& operator<<(std::ostream& stream, const Big_Float& value);
+
+} //namespace multiprecision
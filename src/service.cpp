@@ -0,0 +1,562 @@
+#include "service.hpp"
+#include "isolation_engine.hpp"
+
+#include <algorithm>
+#include <numeric>
+#include <cmath>
+#include <cstring>
+#include <cstdio>
+#include <exception>
+
+#if defined(_WIN32)
+	#include <winsock2.h>
+	#include <afunix.h>
+	#pragma comment(lib, "Ws2_32.lib")
+#else
+	#include <sys/socket.h>
+	#include <sys/un.h>
+	#include <poll.h>
+	#include <unistd.h>
+#endif
+
+using namespace polynomial;
+
+//thin layer over the native sockets, handles are stored as std::intptr_t in the headers (SOCKET on windows, int else)
+namespace socket_io {
+
+	constexpr std::intptr_t invalid = -1;
+
+#if defined(_WIN32)
+	using Native = SOCKET;
+	constexpr int no_signal = 0;
+
+	void start_up()
+	{
+		static const bool started = []() {
+			WSADATA data;
+			return WSAStartup(MAKEWORD(2, 2), &data) == 0;
+		}();
+		if (!started) {
+			throw std::exception("WSAStartup failed");
+		}
+	}
+
+	void close(std::intptr_t s) { ::closesocket(static_cast<Native>(s)); }
+	void shut_down(std::intptr_t s) { ::shutdown(static_cast<Native>(s), SD_BOTH); }
+	void remove_file(const std::string& path) { std::remove(path.c_str()); }
+
+	bool wait_readable(std::intptr_t s, std::chrono::milliseconds timeout)
+	{
+		WSAPOLLFD descriptor = { static_cast<Native>(s), POLLRDNORM, 0 };
+		return ::WSAPoll(&descriptor, 1, static_cast<INT>(timeout.count())) != 0;
+	}
+#else
+	using Native = int;
+	constexpr int no_signal = MSG_NOSIGNAL;	//a closed peer gives an error instead of SIGPIPE
+
+	void start_up() {}
+
+	void close(std::intptr_t s) { ::close(static_cast<Native>(s)); }
+	void shut_down(std::intptr_t s) { ::shutdown(static_cast<Native>(s), SHUT_RDWR); }
+	void remove_file(const std::string& path) { ::unlink(path.c_str()); }
+
+	bool wait_readable(std::intptr_t s, std::chrono::milliseconds timeout)
+	{
+		pollfd descriptor = { static_cast<Native>(s), POLLIN, 0 };
+		return ::poll(&descriptor, 1, static_cast<int>(timeout.count())) != 0;
+	}
+#endif
+
+	sockaddr_un address(const std::string& path)
+	{
+		sockaddr_un result = {};
+		result.sun_family = AF_UNIX;
+		if (path.size() >= sizeof(result.sun_path)) {
+			throw std::exception("socket path too long");
+		}
+		std::memcpy(result.sun_path, path.c_str(), path.size() + 1);
+		return result;
+	}
+
+	std::intptr_t open_socket()
+	{
+		start_up();
+		const Native s = ::socket(AF_UNIX, SOCK_STREAM, 0);
+		if (static_cast<std::intptr_t>(s) == invalid) {
+			throw std::exception("could not create socket");
+		}
+		return static_cast<std::intptr_t>(s);
+	}
+
+	std::intptr_t listen_at(const std::string& path)
+	{
+		const sockaddr_un where = address(path);
+		const std::intptr_t s = open_socket();
+		remove_file(path);
+		if (::bind(static_cast<Native>(s), reinterpret_cast<const sockaddr*>(&where), sizeof(where)) != 0 ||
+			::listen(static_cast<Native>(s), SOMAXCONN) != 0)
+		{
+			close(s);
+			throw std::exception("could not listen at socket path");
+		}
+		return s;
+	}
+
+	std::intptr_t connect_to(const std::string& path)
+	{
+		const sockaddr_un where = address(path);
+		const std::intptr_t s = open_socket();
+		if (::connect(static_cast<Native>(s), reinterpret_cast<const sockaddr*>(&where), sizeof(where)) != 0) {
+			close(s);
+			throw std::exception("could not connect to socket path");
+		}
+		return s;
+	}
+
+	std::intptr_t accept_from(std::intptr_t listener)
+	{
+		const Native s = ::accept(static_cast<Native>(listener), nullptr, nullptr);
+		return static_cast<std::intptr_t>(s);
+	}
+
+	//false if the connection was closed (or broke) before size bytes arrived
+	bool read_all(std::intptr_t s, void* data, std::size_t size)
+	{
+		char* position = static_cast<char*>(data);
+		while (size > 0) {
+			const auto received = ::recv(static_cast<Native>(s), position, static_cast<int>(std::min<std::size_t>(size, 1 << 20)), 0);
+			if (received <= 0) {
+				return false;
+			}
+			position += received;
+			size -= received;
+		}
+		return true;
+	}
+
+	//reads size bytes and throws them away, false as read_all
+	bool skip(std::intptr_t s, std::size_t size)
+	{
+		std::vector<char> buffer(std::min<std::size_t>(size, 1 << 16));
+		while (size > 0) {
+			const std::size_t part = std::min(size, buffer.size());
+			if (!read_all(s, buffer.data(), part)) {
+				return false;
+			}
+			size -= part;
+		}
+		return true;
+	}
+
+	bool write_all(std::intptr_t s, const void* data, std::size_t size)
+	{
+		const char* position = static_cast<const char*>(data);
+		while (size > 0) {
+			const auto sent = ::send(static_cast<Native>(s), position, static_cast<int>(std::min<std::size_t>(size, 1 << 20)), no_signal);
+			if (sent <= 0) {
+				return false;
+			}
+			position += sent;
+			size -= sent;
+		}
+		return true;
+	}
+
+} //namespace socket_io
+
+namespace service {
+
+	template<typename T>
+	void append(std::vector<char>& message, const T& value)
+	{
+		const char* const bytes = reinterpret_cast<const char*>(&value);
+		message.insert(message.end(), bytes, bytes + sizeof(T));
+	}
+
+	bool valid(const wire::Request_Header& header)
+	{
+		switch (header.kind) {
+		case wire::Request_Kind::statistics:
+			return header.coefficient_count == 0;
+		case wire::Request_Kind::isolate:
+			return header.coefficient_count > 0 && header.coefficient_count <= wire::max_coefficient_count &&
+				std::isfinite(header.min) && std::isfinite(header.max) && header.min < header.max &&
+				header.min_width > 0.0;
+		}
+		return false;
+	}
+
+	double percentile(std::vector<double>& values, double fraction)
+	{
+		if (values.empty()) {
+			return 0.0;
+		}
+		const std::size_t index = std::min(values.size() - 1, static_cast<std::size_t>(fraction * values.size()));
+		std::nth_element(values.begin(), values.begin() + index, values.end());
+		return values[index];
+	}
+
+} //namespace service
+
+struct Isolation_Service::Connection
+{
+	std::intptr_t socket;
+	std::atomic<bool> closed = false;	//set by the reader when it is done
+
+	//responses finished out of order wait in pending until all before them are sent
+	std::mutex write_mutex;
+	std::uint64_t next_to_send = 0;
+	std::map<std::uint64_t, std::vector<char>> pending;
+
+	Connection(std::intptr_t socket_) :socket(socket_) {}
+	~Connection() { socket_io::close(this->socket); }
+};
+
+Isolation_Service::Isolation_Service(const Settings& settings_)
+	:settings(settings_), start(Clock::now()), listener(socket_io::listen_at(settings_.socket_path))
+{
+	binomial_coefficients(1);	//builds the static binomial table now instead of in the first request
+	this->latencies.reserve(latency_window);
+
+	std::size_t threads = this->settings.threads != 0 ? this->settings.threads : std::max(1u, std::thread::hardware_concurrency());
+	this->settings.max_batch = std::max<std::size_t>(this->settings.max_batch, 1);
+	this->running = true;
+	for (std::size_t i = 0; i < threads; i++) {
+		this->workers.emplace_back(&Isolation_Service::work_loop, this);
+	}
+	this->acceptor = std::thread(&Isolation_Service::accept_loop, this);
+}
+
+Isolation_Service::~Isolation_Service()
+{
+	this->stop();
+}
+
+void Isolation_Service::stop()
+{
+	if (!this->running.exchange(false)) {
+		return;
+	}
+	socket_io::shut_down(this->listener);	//wakes the acceptor at once on linux, else it notices running at its next timeout
+	this->acceptor.join();
+	socket_io::close(this->listener);
+	socket_io::remove_file(this->settings.socket_path);
+	{
+		//readers are woken up by shutting down their connections, which also ends the requests not yet read
+		std::lock_guard lock(this->connections_mutex);
+		for (auto& [reader, connection] : this->readers) {
+			socket_io::shut_down(connection->socket);
+		}
+	}
+	for (auto& [reader, connection] : this->readers) {
+		reader.join();
+	}
+	this->readers.clear();
+
+	{
+		std::lock_guard lock(this->queue_mutex);	//a worker between its check of running and its wait would miss the notification otherwise
+	}
+	this->queue_filled.notify_all();
+	for (auto& worker : this->workers) {
+		worker.join();
+	}
+	this->workers.clear();
+}
+
+void Isolation_Service::accept_loop()
+{
+	std::chrono::milliseconds backoff = min_accept_backoff;
+	while (this->running) {
+		//accept only after waiting with a timeout: on windows neither shutdown nor closesocket of the listener
+		//reliably wake up a thread blocked in accept, so stop() could never join it
+		if (!socket_io::wait_readable(this->listener, accept_poll_interval)) {
+			continue;
+		}
+		const std::intptr_t s = socket_io::accept_from(this->listener);
+		if (s == socket_io::invalid) {
+			//either stop() shut the listener down or accepting failed. errors like running out of file descriptors
+			//persist for a while, retrying at once would only spin
+			std::this_thread::sleep_for(backoff);
+			backoff = std::min(2 * backoff, max_accept_backoff);
+			continue;
+		}
+		backoff = min_accept_backoff;
+		auto connection = std::make_shared<Connection>(s);
+
+		std::lock_guard lock(this->connections_mutex);
+		//join readers of connections closed in the meantime, so they do not pile up over the lifetime of the service
+		const auto finished = std::partition(this->readers.begin(), this->readers.end(), [](const auto& reader) { return !reader.second->closed; });
+		for (auto reader = finished; reader != this->readers.end(); ++reader) {
+			reader->first.join();
+		}
+		this->readers.erase(finished, this->readers.end());
+		this->readers.emplace_back(std::thread(&Isolation_Service::read_loop, this, connection), connection);
+	}
+}
+
+void Isolation_Service::read_loop(std::shared_ptr<Connection> connection)
+{
+	std::uint64_t sequence = 0;
+	wire::Request_Header header;
+	while (socket_io::read_all(connection->socket, &header, sizeof(header))) {
+		if (header.magic != wire::magic) {
+			//the stream can not be trusted to continue at a request boundary. shutting it down tells the client,
+			//which would otherwise wait for a response forever
+			socket_io::shut_down(connection->socket);
+			break;
+		}
+		//the coefficients of a request too long to be processed are skipped, it is answered as invalid in order
+		const bool too_long = header.coefficient_count > wire::max_coefficient_count;
+		Job job = { connection, sequence++, header, std::vector<double>(too_long ? 0 : header.coefficient_count), Clock::now() };
+		const bool complete = too_long ?
+			socket_io::skip(connection->socket, std::size_t(header.coefficient_count) * sizeof(double)) :
+			socket_io::read_all(connection->socket, job.coefficients.data(), job.coefficients.size() * sizeof(double));
+		if (!complete) {
+			break;
+		}
+		{
+			std::lock_guard lock(this->queue_mutex);
+			this->queue.push_back(std::move(job));
+		}
+		this->queue_filled.notify_one();
+	}
+	connection->closed = true;
+}
+
+void Isolation_Service::work_loop()
+{
+	std::vector<Job> batch;
+	batch.reserve(this->settings.max_batch);
+	while (true) {
+		{
+			std::unique_lock lock(this->queue_mutex);
+			this->queue_filled.wait(lock, [this]() { return !this->queue.empty() || !this->running; });
+			if (this->queue.empty()) {
+				return;
+			}
+			const std::size_t count = std::min(this->queue.size(), this->settings.max_batch);
+			std::move(this->queue.begin(), this->queue.begin() + count, std::back_inserter(batch));
+			this->queue.erase(this->queue.begin(), this->queue.begin() + count);
+		}
+		{
+			std::lock_guard lock(this->statistics_mutex);
+			this->batches++;
+		}
+		this->process_batch(batch);
+		batch.clear();
+	}
+}
+
+void Isolation_Service::process_batch(std::vector<Job>& batch)
+{
+	using Isolate = isolation::Engine<isolation::Min_Width, isolation::Midpoint_Split, isolation::Left_To_Right>;
+
+	//isolation requests sharing degree and interval are converted to bernstein base with one matrix product
+	std::vector<std::size_t> order;
+	order.reserve(batch.size());
+	for (std::size_t i = 0; i < batch.size(); i++) {
+		const wire::Request_Header& header = batch[i].header;
+		if (!service::valid(header)) {
+			this->respond(batch[i], wire::Status::invalid_request, {});
+		}
+		else if (header.kind == wire::Request_Kind::statistics) {
+			const Service_Statistics current = this->statistics();
+			std::vector<char> message;
+			service::append(message, wire::Response_Header{ header.id, wire::Status::ok, 0 });
+			service::append(message, current);
+			this->respond(batch[i], std::move(message));
+		}
+		else {
+			order.push_back(i);
+		}
+	}
+	const auto key = [&batch](std::size_t i) {
+		return std::make_tuple(batch[i].header.coefficient_count, batch[i].header.min, batch[i].header.max);
+	};
+	std::sort(order.begin(), order.end(), [&key](std::size_t i, std::size_t j) { return key(i) < key(j); });
+
+	std::vector<double> monomials;
+	std::vector<double> bernstein;
+	for (auto group_begin = order.begin(); group_begin != order.end();) {
+		const auto group_end = std::find_if(group_begin, order.end(), [&](std::size_t i) { return key(i) != key(*group_begin); });
+		const std::size_t count = group_end - group_begin;
+		const wire::Request_Header& first = batch[*group_begin].header;
+		const std::size_t size = first.coefficient_count;
+		const Interval interval = { first.min, first.max };
+
+		//a plan is a dense (n+1)x(n+1) matrix built in O(n^3), beyond max_plan_degree each request is converted alone in O(n^2)
+		bool converted = false;
+		if (size - 1 <= max_plan_degree) {
+			try {
+				monomials.resize(count * size);
+				bernstein.resize(count * size);
+				for (std::size_t k = 0; k < count; k++) {
+					std::copy(batch[group_begin[k]].coefficients.begin(), batch[group_begin[k]].coefficients.end(), monomials.begin() + k * size);
+				}
+				this->plan(size - 1, interval)->execute_batch(monomials.data(), bernstein.data(), count);
+				converted = true;
+			}
+			catch (const std::exception&) {}	//the requests are converted one by one below, each failing on its own
+		}
+
+		for (std::size_t k = 0; k < count; k++) {
+			Job& job = batch[group_begin[k]];
+			try {
+				const Bernstein b = converted ?
+					Bernstein(Coefficients(bernstein.data() + k * size, bernstein.data() + (k + 1) * size), interval) :
+					to_bernstein(Monomials(std::move(job.coefficients)), interval);
+				this->respond(job, wire::Status::ok, Isolate(isolation::Min_Width{ job.header.min_width })(b));
+			}
+			catch (const std::exception&) {
+				this->respond(job, wire::Status::failed, {});
+			}
+		}
+		group_begin = group_end;
+	}
+}
+
+std::shared_ptr<const Bernstein_Plan> Isolation_Service::plan(std::size_t degree, const Interval& interval)
+{
+	const Plan_Key key = { degree, interval.min, interval.max };
+	{
+		std::lock_guard lock(this->plan_mutex);
+		const auto found = this->plans.find(key);
+		if (found != this->plans.end()) {
+			std::lock_guard statistics_lock(this->statistics_mutex);
+			this->plan_cache_hits++;
+			return found->second;
+		}
+	}
+	//built outside of the lock, as this is the expensive part. if two workers build the same plan, one is thrown away
+	auto result = std::make_shared<const Bernstein_Plan>(degree, interval);
+	std::lock_guard lock(this->plan_mutex);
+	if (this->plans.size() >= max_cached_plans) {
+		this->plans.clear();	//clients use few distinct degrees and intervals, so this should hardly ever happen
+	}
+	return this->plans.emplace(key, std::move(result)).first->second;
+}
+
+void Isolation_Service::respond(Job& job, wire::Status status, const std::vector<Interval>& intervals)
+{
+	std::vector<char> message;
+	message.reserve(sizeof(wire::Response_Header) + intervals.size() * sizeof(Interval));
+	service::append(message, wire::Response_Header{ job.header.id, status, static_cast<std::uint32_t>(intervals.size()) });
+	for (const Interval& interval : intervals) {
+		service::append(message, interval.min);
+		service::append(message, interval.max);
+	}
+	this->respond(job, std::move(message));
+}
+
+void Isolation_Service::respond(Job& job, std::vector<char>&& message)
+{
+	Connection& connection = *job.connection;
+	{
+		std::lock_guard lock(connection.write_mutex);
+		connection.pending.emplace(job.sequence, std::move(message));
+		for (auto next = connection.pending.begin(); next != connection.pending.end() && next->first == connection.next_to_send;) {
+			socket_io::write_all(connection.socket, next->second.data(), next->second.size());	//a vanished client is no error here
+			next = connection.pending.erase(next);
+			connection.next_to_send++;
+		}
+	}
+	this->record_completion(job.arrival);
+}
+
+void Isolation_Service::record_completion(Clock::time_point arrival)
+{
+	const Clock::time_point now = Clock::now();
+	const double latency = std::chrono::duration<double, std::micro>(now - arrival).count();
+
+	std::lock_guard lock(this->statistics_mutex);
+	if (this->latencies.size() < latency_window) {
+		this->latencies.push_back(latency);
+	}
+	else {
+		this->latencies[this->requests % latency_window] = latency;
+	}
+	this->requests++;
+	this->completions.push_back(now);
+	while (now - this->completions.front() > throughput_window) {
+		this->completions.pop_front();
+	}
+}
+
+Service_Statistics Isolation_Service::statistics()
+{
+	const Clock::time_point now = Clock::now();
+	std::vector<double> window;
+	Service_Statistics result = {};
+	{
+		std::lock_guard lock(this->statistics_mutex);
+		window = this->latencies;
+		result.requests = this->requests;
+		result.batches = this->batches;
+		result.plan_cache_hits = this->plan_cache_hits;
+		while (!this->completions.empty() && now - this->completions.front() > throughput_window) {
+			this->completions.pop_front();
+		}
+		result.uptime_seconds = std::chrono::duration<double>(now - this->start).count();
+		const double measured = std::min(result.uptime_seconds, std::chrono::duration<double>(throughput_window).count());
+		result.throughput = measured > 0.0 ? this->completions.size() / measured : 0.0;
+	}
+	{
+		std::lock_guard lock(this->plan_mutex);
+		result.cached_plans = this->plans.size();
+	}
+	result.latency_p50 = service::percentile(window, 0.50);
+	result.latency_p90 = service::percentile(window, 0.90);
+	result.latency_p99 = service::percentile(window, 0.99);
+	result.latency_max = window.empty() ? 0.0 : *std::max_element(window.begin(), window.end());
+	return result;
+}
+
+Service_Client::Service_Client(const std::string& socket_path)
+	:connection(socket_io::connect_to(socket_path))
+{}
+
+Service_Client::~Service_Client()
+{
+	socket_io::close(this->connection);
+}
+
+std::vector<Interval> Service_Client::isolate(const Monomials& p, const Interval& start_zone, double min_width)
+{
+	const wire::Request_Header header = { wire::magic, wire::Request_Kind::isolate, this->next_id++,
+		static_cast<std::uint32_t>(p.size()), 0, start_zone.min, start_zone.max, min_width };
+	if (!socket_io::write_all(this->connection, &header, sizeof(header)) ||
+		!socket_io::write_all(this->connection, p.data(), p.size() * sizeof(double)))
+	{
+		throw std::exception("could not send request");
+	}
+	wire::Response_Header response;
+	if (!socket_io::read_all(this->connection, &response, sizeof(response))) {
+		throw std::exception("no response");
+	}
+	std::vector<Interval> result(response.interval_count);
+	for (Interval& interval : result) {
+		if (!socket_io::read_all(this->connection, &interval.min, sizeof(double)) ||
+			!socket_io::read_all(this->connection, &interval.max, sizeof(double)))
+		{
+			throw std::exception("incomplete response");
+		}
+	}
+	if (response.status != wire::Status::ok) {
+		throw std::exception("request rejected by service");
+	}
+	return result;
+}
+
+Service_Statistics Service_Client::statistics()
+{
+	const wire::Request_Header header = { wire::magic, wire::Request_Kind::statistics, this->next_id++, 0, 0, 0.0, 0.0, 0.0 };
+	wire::Response_Header response;
+	Service_Statistics result;
+	if (!socket_io::write_all(this->connection, &header, sizeof(header)) ||
+		!socket_io::read_all(this->connection, &response, sizeof(response)) ||
+		!socket_io::read_all(this->connection, &result, sizeof(result)))
+	{
+		throw std::exception("statistics request failed");
+	}
+	return result;
+}
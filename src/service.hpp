@@ -0,0 +1,184 @@
+#pragma once
+
+#include <cstdint>
+#include <cstddef>
+#include <string>
+#include <vector>
+#include <deque>
+#include <map>
+#include <tuple>
+#include <utility>
+#include <memory>
+#include <mutex>
+#include <condition_variable>
+#include <thread>
+#include <atomic>
+#include <chrono>
+
+#include "descartes.hpp"
+
+//long running root isolation over a unix domain socket (see service_main.cpp for the executable).
+//keeps its worker threads, the binomial table and the bernstein plans warm between requests,
+//concurrent requests are taken from one queue in batches and converted to bernstein base together.
+//
+//wire format (all values in host byte order, the service is only reachable locally anyway):
+//  request:  Request_Header, then coefficient_count doubles (coefficients[i] belongs to x^i)
+//  response: Response_Header, then 2 * interval_count doubles (pairs min, max in ascending order)
+//            or for Request_Kind::statistics a Service_Statistics
+//responses on one connection are sent in the order the requests arrived.
+namespace wire {
+
+	constexpr std::uint32_t magic = 0x31435344;	//"DSC1"
+
+	enum class Request_Kind : std::uint32_t
+	{
+		isolate = 0,
+		statistics = 1,
+	};
+
+	enum class Status : std::uint32_t
+	{
+		ok = 0,
+		invalid_request = 1,
+		failed = 2,
+	};
+
+	struct Request_Header
+	{
+		std::uint32_t magic;
+		Request_Kind kind;
+		std::uint64_t id;	//returned unchanged in the response
+		std::uint32_t coefficient_count;	//degree + 1, 0 for Request_Kind::statistics
+		std::uint32_t reserved;
+		double min;
+		double max;
+		double min_width;	//intervals narrower than this are accepted as final
+	};
+
+	struct Response_Header
+	{
+		std::uint64_t id;
+		Status status;
+		std::uint32_t interval_count;
+	};
+
+	//degree 100, the highest degree to_bernstein supports. longer requests are answered with Status::invalid_request
+	constexpr std::uint32_t max_coefficient_count = 101;
+
+} //namespace wire
+
+//latencies are measured from the arrival of a request to the moment its response is written,
+//percentiles refer to the last Isolation_Service::latency_window requests
+struct Service_Statistics
+{
+	std::uint64_t requests;
+	std::uint64_t batches;	//requests / batches is the average batch size
+	std::uint64_t cached_plans;
+	std::uint64_t plan_cache_hits;
+	double uptime_seconds;
+	double throughput;	//completed requests per second over the last Isolation_Service::throughput_window
+	double latency_p50;	//in microseconds
+	double latency_p90;
+	double latency_p99;
+	double latency_max;
+};
+
+class Isolation_Service
+{
+public:
+	static constexpr std::size_t latency_window = 4096;
+	static constexpr std::chrono::seconds throughput_window{ 10 };
+	static constexpr std::size_t max_cached_plans = 256;
+	static constexpr std::size_t max_plan_degree = 64;	//higher degrees are converted per request instead of with a cached Bernstein_Plan
+	static constexpr std::chrono::milliseconds accept_poll_interval{ 100 };	//longest time stop() waits for the acceptor
+	static constexpr std::chrono::milliseconds min_accept_backoff{ 1 };	//pause after a failed accept, doubled up to the max
+	static constexpr std::chrono::milliseconds max_accept_backoff{ 1000 };
+
+	struct Settings
+	{
+		std::string socket_path;
+		std::size_t threads = 0;	//0 uses std::thread::hardware_concurrency()
+		std::size_t max_batch = 64;	//at most so many requests are taken from the queue at once
+	};
+
+	using Clock = std::chrono::steady_clock;
+
+private:
+	struct Connection;
+
+	struct Job
+	{
+		std::shared_ptr<Connection> connection;
+		std::uint64_t sequence;	//position of the request on its connection
+		wire::Request_Header header;
+		std::vector<double> coefficients;
+		Clock::time_point arrival;
+	};
+
+	using Plan_Key = std::tuple<std::size_t, double, double>;	//degree, interval
+
+	Settings settings;
+	Clock::time_point start;
+	std::atomic<bool> running = false;
+	std::intptr_t listener;
+
+	std::mutex queue_mutex;
+	std::condition_variable queue_filled;
+	std::deque<Job> queue;
+
+	std::mutex plan_mutex;
+	std::map<Plan_Key, std::shared_ptr<const Bernstein_Plan>> plans;
+
+	std::mutex statistics_mutex;
+	std::uint64_t requests = 0;
+	std::uint64_t batches = 0;
+	std::uint64_t plan_cache_hits = 0;
+	std::vector<double> latencies;	//ring buffer of the last latency_window latencies
+	std::deque<Clock::time_point> completions;	//of the last throughput_window
+
+	std::vector<std::thread> workers;
+	std::thread acceptor;
+	std::mutex connections_mutex;
+	std::vector<std::pair<std::thread, std::shared_ptr<Connection>>> readers;
+
+	void accept_loop();
+	void read_loop(std::shared_ptr<Connection> connection);
+	void work_loop();
+	void process_batch(std::vector<Job>& batch);
+	std::shared_ptr<const Bernstein_Plan> plan(std::size_t degree, const Interval& interval);
+	void respond(Job& job, wire::Status status, const std::vector<Interval>& intervals);
+	void respond(Job& job, std::vector<char>&& message);	//sends message as soon as all responses before it on the connection are sent
+	void record_completion(Clock::time_point arrival);
+
+public:
+	//binds to settings.socket_path (an existing file there is replaced) and starts all threads.
+	//throws if the socket could not be created
+	Isolation_Service(const Settings& settings_);
+	~Isolation_Service();
+
+	Isolation_Service(const Isolation_Service&) = delete;
+	Isolation_Service& operator=(const Isolation_Service&) = delete;
+
+	//stops accepting, finishes the queued requests and joins all threads
+	void stop();
+
+	Service_Statistics statistics();
+};
+
+//blocking client for one connection to an Isolation_Service, throws if the connection fails
+class Service_Client
+{
+	std::intptr_t connection;
+	std::uint64_t next_id = 0;
+
+public:
+	Service_Client(const std::string& socket_path);
+	~Service_Client();
+
+	Service_Client(const Service_Client&) = delete;
+	Service_Client& operator=(const Service_Client&) = delete;
+
+	std::vector<Interval> isolate(const polynomial::Monomials& p, const Interval& start_zone, double min_width = 0.000001);
+
+	Service_Statistics statistics();
+};
@@ -0,0 +1,44 @@
+#include <iostream>
+#include <string>
+#include <cstdlib>
+#include <csignal>
+#include <atomic>
+#include <thread>
+#include <chrono>
+
+#include "service.hpp"
+
+//usage: descartes_service [socket path] [threads]
+//prints the statistics every 10 seconds, stops on ctrl+c (or SIGTERM)
+
+namespace service_main {
+	std::atomic<bool> stop_requested = false;
+}
+
+int main(int argc, char** argv)
+{
+	Isolation_Service::Settings settings;
+	settings.socket_path = argc > 1 ? argv[1] : "descartes.sock";
+	settings.threads = argc > 2 ? std::strtoul(argv[2], nullptr, 10) : 0;
+
+	std::signal(SIGINT, [](int) { service_main::stop_requested = true; });
+	std::signal(SIGTERM, [](int) { service_main::stop_requested = true; });
+
+	Isolation_Service service(settings);
+	std::cout << "listening at " << settings.socket_path << std::endl;
+
+	auto last_report = std::chrono::steady_clock::now();
+	while (!service_main::stop_requested) {
+		std::this_thread::sleep_for(std::chrono::milliseconds(200));
+		if (std::chrono::steady_clock::now() - last_report < std::chrono::seconds(10)) {
+			continue;
+		}
+		last_report = std::chrono::steady_clock::now();
+		const Service_Statistics s = service.statistics();
+		std::cout << "requests " << s.requests << " (" << s.throughput << "/s)"
+			<< ", batch size " << (s.batches > 0 ? static_cast<double>(s.requests) / s.batches : 0.0)
+			<< ", latency us p50 " << s.latency_p50 << " p90 " << s.latency_p90 << " p99 " << s.latency_p99 << " max " << s.latency_max
+			<< ", plans " << s.cached_plans << " (" << s.plan_cache_hits << " hits)" << std::endl;
+	}
+	service.stop();
+}
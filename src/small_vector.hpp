@@ -0,0 +1,195 @@
+#pragma once
+
+#include <cstddef>
+#include <cassert>
+#include <algorithm>
+#include <initializer_list>
+#include <iterator>
+#include <type_traits>
+#include <vector>
+
+//vector with room for inline_capacity elements inside the object itself, only larger sizes are stored on the heap.
+//elements are copied with memcpy semantics, thus only trivially copyable types are allowed.
+//(used as storage of polynomial::Monomials and polynomial::Bernstein, so polynomials of low degree need no allocation at all)
+template<typename T, std::size_t inline_capacity>
+class Small_Vector
+{
+	static_assert(std::is_trivially_copyable_v<T>);
+
+private:
+	T* heap = nullptr;	//nullptr as long as the elements fit into buffer
+	std::size_t count = 0;
+	std::size_t room = inline_capacity;
+	T buffer[inline_capacity];
+
+	//makes room for at least new_room elements, keeps the current elements
+	void grow(std::size_t new_room)
+	{
+		new_room = std::max(new_room, 2 * this->room);
+		T* const new_heap = new T[new_room];
+		std::copy(this->begin(), this->end(), new_heap);
+		delete[] this->heap;
+		this->heap = new_heap;
+		this->room = new_room;
+	}
+
+public:
+	using value_type = T;
+	using size_type = std::size_t;
+	using difference_type = std::ptrdiff_t;
+	using reference = T&;
+	using const_reference = const T&;
+	using pointer = T*;
+	using const_pointer = const T*;
+	using iterator = T*;
+	using const_iterator = const T*;
+	using reverse_iterator = std::reverse_iterator<iterator>;
+	using const_reverse_iterator = std::reverse_iterator<const_iterator>;
+
+	Small_Vector() = default;
+
+	Small_Vector(std::size_t size, const T& value) { this->assign(size, value); }
+
+	Small_Vector(std::initializer_list<T> values) { this->assign(values.begin(), values.end()); }
+
+	template<typename Iterator, typename = typename std::iterator_traits<Iterator>::iterator_category>
+	Small_Vector(Iterator first, Iterator last) { this->assign(first, last); }
+
+	explicit Small_Vector(const std::vector<T>& values) { this->assign(values.begin(), values.end()); }
+
+	Small_Vector(const Small_Vector& other) { this->assign(other.begin(), other.end()); }
+
+	Small_Vector(Small_Vector&& other) noexcept { *this = std::move(other); }
+
+	Small_Vector& operator=(const Small_Vector& other)
+	{
+		if (this != &other) {
+			this->assign(other.begin(), other.end());
+		}
+		return *this;
+	}
+
+	//a heap block is taken over, inline elements are copied
+	Small_Vector& operator=(Small_Vector&& other) noexcept
+	{
+		if (this == &other) {
+			return *this;
+		}
+		if (other.heap) {
+			delete[] this->heap;
+			this->heap = other.heap;
+			this->room = other.room;
+			other.heap = nullptr;
+			other.room = inline_capacity;
+		}
+		else {
+			std::copy(other.begin(), other.end(), this->begin());	//fits, as our room is at least inline_capacity
+		}
+		this->count = other.count;
+		other.count = 0;
+		return *this;
+	}
+
+	~Small_Vector() { delete[] this->heap; }
+
+	T* data() { return this->heap ? this->heap : this->buffer; }
+	const T* data() const { return this->heap ? this->heap : this->buffer; }
+
+	std::size_t size() const { return this->count; }
+	std::size_t capacity() const { return this->room; }
+	bool empty() const { return this->count == 0; }
+	bool is_inline() const { return this->heap == nullptr; }
+
+	T* begin() { return this->data(); }
+	T* end() { return this->data() + this->count; }
+	const T* begin() const { return this->data(); }
+	const T* end() const { return this->data() + this->count; }
+	const T* cbegin() const { return this->begin(); }
+	const T* cend() const { return this->end(); }
+	reverse_iterator rbegin() { return reverse_iterator(this->end()); }
+	reverse_iterator rend() { return reverse_iterator(this->begin()); }
+	const_reverse_iterator rbegin() const { return const_reverse_iterator(this->end()); }
+	const_reverse_iterator rend() const { return const_reverse_iterator(this->begin()); }
+
+	T& operator[](std::size_t index) { assert(index < this->count); return this->data()[index]; }
+	const T& operator[](std::size_t index) const { assert(index < this->count); return this->data()[index]; }
+	T& front() { return (*this)[0]; }
+	const T& front() const { return (*this)[0]; }
+	T& back() { return (*this)[this->count - 1]; }
+	const T& back() const { return (*this)[this->count - 1]; }
+
+	void reserve(std::size_t new_room)
+	{
+		if (new_room > this->room) {
+			this->grow(new_room);
+		}
+	}
+
+	void resize(std::size_t new_size, const T& value = T())
+	{
+		this->reserve(new_size);
+		if (new_size > this->count) {
+			std::fill(this->data() + this->count, this->data() + new_size, value);
+		}
+		this->count = new_size;
+	}
+
+	void clear() { this->count = 0; }
+
+	void push_back(const T& value)
+	{
+		if (this->count == this->room) {
+			const T copy = value;	//value may live inside this
+			this->grow(this->count + 1);
+			this->data()[this->count++] = copy;
+		}
+		else {
+			this->data()[this->count++] = value;
+		}
+	}
+
+	template<typename... Args>
+	T& emplace_back(Args&&... args)
+	{
+		this->push_back(T(std::forward<Args>(args)...));
+		return this->back();
+	}
+
+	void pop_back() { assert(this->count > 0); this->count--; }
+
+	void assign(std::size_t size, const T& value)
+	{
+		this->clear();
+		this->resize(size, value);
+	}
+
+	template<typename Iterator>
+	void assign(Iterator first, Iterator last)
+	{
+		this->clear();
+		this->reserve(static_cast<std::size_t>(std::distance(first, last)));
+		this->count = static_cast<std::size_t>(std::copy(first, last, this->data()) - this->data());
+	}
+
+	T* insert(const T* position, const T& value)
+	{
+		const std::size_t index = position - this->data();
+		this->push_back(value);
+		std::rotate(this->begin() + index, this->end() - 1, this->end());
+		return this->begin() + index;
+	}
+
+	T* erase(const T* first, const T* last)
+	{
+		T* const first_ = this->begin() + (first - this->data());
+		T* const last_ = this->begin() + (last - this->data());
+		std::copy(last_, this->end(), first_);
+		this->count -= last_ - first_;
+		return first_;
+	}
+
+	T* erase(const T* position) { return this->erase(position, position + 1); }
+
+	friend bool operator==(const Small_Vector& a, const Small_Vector& b) { return std::equal(a.begin(), a.end(), b.begin(), b.end()); }
+	friend bool operator!=(const Small_Vector& a, const Small_Vector& b) { return !(a == b); }
+};
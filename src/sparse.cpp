@@ -0,0 +1,276 @@
+#include "sparse.hpp"
+
+#include <cmath>
+#include <algorithm>
+#include <limits>
+#include <cassert>
+
+using namespace polynomial;
+
+namespace sparse {
+
+	//x^exponent by repeated squaring
+	double power(double x, std::uint64_t exponent)
+	{
+		double result = 1.0;
+		while (exponent > 0) {
+			if (exponent & 1) {
+				result *= x;
+			}
+			x *= x;
+			exponent >>= 1;
+		}
+		return result;
+	}
+
+	//p * x^-(lowest exponent of p), does not change the roots other than 0
+	Sparse without_lowest_power(const Sparse& p)
+	{
+		Sparse result = p;
+		const std::uint64_t lowest = p.empty() ? 0 : p.front().exponent;
+		for (Sparse_Term& term : result) {
+			term.exponent -= lowest;
+		}
+		return result;
+	}
+
+	//fujiwara: all roots have an absolute value below 2 * max_i |c_i / c_n|^(1 / (n - e_i))
+	double root_bound(const Sparse& p)
+	{
+		const Sparse_Term& leading = p.back();
+		double bound = 0.0;
+		for (std::size_t i = 0; i + 1 < p.size(); i++) {
+			const double ratio = std::abs(p[i].coefficient / leading.coefficient);
+			bound = std::max(bound, std::pow(ratio, 1.0 / (leading.exponent - p[i].exponent)));
+		}
+		return 2.0 * bound;
+	}
+
+	//shrinks [min, max] with sign_at(p, min) * sign_at(p, max) < 0 by bisection until it is at most width wide.
+	//width 0 bisects until the two ends are neighbouring doubles
+	Interval bisect(const Sparse& p, Interval interval, double width)
+	{
+		const int sign_min = sign_at(p, interval.min);
+		while (interval.width() > width) {
+			const double middle = interval.min / 2 + interval.max / 2;
+			if (middle <= interval.min || middle >= interval.max) {
+				break;
+			}
+			const int sign_middle = sign_at(p, middle);
+			if (sign_middle == 0) {
+				return Interval{ middle, middle };
+			}
+			(sign_middle == sign_min ? interval.min : interval.max) = middle;
+		}
+		return interval;
+	}
+
+	//roots of p in the open interval (min, max) with 0 <= min < max
+	std::vector<Interval> positive_roots(const Sparse& p, const Interval& zone, double min_width)
+	{
+		if (p.size() <= 1) {
+			return {};	//c * x^e has no positive roots
+		}
+		//between neighbouring critical points p is monotone. they are refined as far as doubles allow, so that only
+		//roots (practically) at the same position as a critical point can be missed
+		std::vector<double> borders = { zone.min };
+		for (const Interval& critical : positive_roots(derive(without_lowest_power(p)), zone, 0.0)) {
+			borders.push_back(critical.min / 2 + critical.max / 2);
+		}
+		borders.push_back(zone.max);
+
+		std::vector<Interval> result;
+		for (std::size_t i = 0; i + 1 < borders.size(); i++) {
+			const double left = borders[i];
+			const double right = borders[i + 1];
+			const int sign_left = sign_at(p, left);
+			const int sign_right = sign_at(p, right);
+			if (sign_left == 0 && i > 0) {
+				result.push_back(Interval{ left, left });
+			}
+			else if (sign_left * sign_right < 0) {
+				result.push_back(bisect(p, Interval{ left, right }, min_width));
+			}
+		}
+		return result;
+	}
+
+	//positive_roots, but roots exactly at an end of zone (with 0 <= zone.min <= zone.max) are reported as well.
+	//sign_at never returns 0 at 0, a root there is left to the caller
+	std::vector<Interval> closed_positive_roots(const Sparse& p, const Interval& zone, double min_width)
+	{
+		std::vector<Interval> result;
+		if (sign_at(p, zone.min) == 0) {
+			result.push_back(Interval{ zone.min, zone.min });
+		}
+		if (zone.min < zone.max) {
+			const std::vector<Interval> inside = positive_roots(p, zone, min_width);
+			result.insert(result.end(), inside.begin(), inside.end());
+			if (sign_at(p, zone.max) == 0) {
+				result.push_back(Interval{ zone.max, zone.max });
+			}
+		}
+		return result;
+	}
+
+} //namespace sparse
+
+Sparse::Sparse(std::vector<Sparse_Term> terms)
+{
+	std::sort(terms.begin(), terms.end(), [](const Sparse_Term& a, const Sparse_Term& b) { return a.exponent < b.exponent; });
+	for (const Sparse_Term& term : terms) {
+		if (!this->empty() && this->back().exponent == term.exponent) {
+			this->back().coefficient += term.coefficient;
+		}
+		else {
+			if (!this->empty() && this->back().coefficient == 0.0) {
+				this->pop_back();
+			}
+			this->push_back(term);
+		}
+	}
+	if (!this->empty() && this->back().coefficient == 0.0) {
+		this->pop_back();
+	}
+}
+
+Sparse polynomial::to_sparse(const Monomials& p)
+{
+	std::vector<Sparse_Term> terms;
+	for (std::size_t i = 0; i < p.size(); i++) {
+		if (p[i] != 0.0) {
+			terms.push_back(Sparse_Term{ i, p[i] });
+		}
+	}
+	return Sparse(std::move(terms));
+}
+
+Monomials polynomial::to_dense(const Sparse& p)
+{
+	Monomials result(p.degree() + 1, 0.0);
+	for (const Sparse_Term& term : p) {
+		result[term.exponent] = term.coefficient;
+	}
+	return result;
+}
+
+double polynomial::evaluate(const Sparse& p, double x)
+{
+	double result = 0.0;
+	double x_power = 1.0;
+	std::uint64_t exponent = 0;
+	for (const Sparse_Term& term : p) {
+		x_power *= sparse::power(x, term.exponent - exponent);
+		exponent = term.exponent;
+		result += term.coefficient * x_power;
+	}
+	return result;
+}
+
+int polynomial::sign_at(const Sparse& p, double x)
+{
+	if (p.empty()) {
+		return 0;
+	}
+	if (x == 0.0) {
+		return p.front().coefficient > 0.0 ? 1 : -1;
+	}
+	const double log_x = std::log(std::abs(x));
+	const auto log_term = [log_x](const Sparse_Term& term) { return std::log(std::abs(term.coefficient)) + term.exponent * log_x; };
+	double biggest = -std::numeric_limits<double>::infinity();
+	for (const Sparse_Term& term : p) {
+		biggest = std::max(biggest, log_term(term));
+	}
+	double sum = 0.0;
+	for (const Sparse_Term& term : p) {
+		const bool negative = (term.coefficient < 0.0) != (x < 0.0 && term.exponent % 2 == 1);
+		const double scaled = std::exp(log_term(term) - biggest);
+		sum += negative ? -scaled : scaled;
+	}
+	return (sum > 0.0) - (sum < 0.0);
+}
+
+Sparse polynomial::derive(const Sparse& p)
+{
+	Sparse result;
+	result.reserve(p.size());
+	for (const Sparse_Term& term : p) {
+		if (term.exponent > 0) {
+			result.push_back(Sparse_Term{ term.exponent - 1, term.coefficient * term.exponent });
+		}
+	}
+	return result;
+}
+
+Sparse polynomial::reflect(const Sparse& p)
+{
+	Sparse result = p;
+	for (Sparse_Term& term : result) {
+		if (term.exponent % 2 == 1) {
+			term.coefficient = -term.coefficient;
+		}
+	}
+	return result;
+}
+
+Sparse polynomial::operator*(const Sparse& p1, const Sparse& p2)
+{
+	std::vector<Sparse_Term> terms;
+	terms.reserve(p1.size() * p2.size());
+	for (const Sparse_Term& term_1 : p1) {
+		for (const Sparse_Term& term_2 : p2) {
+			terms.push_back(Sparse_Term{ term_1.exponent + term_2.exponent, term_1.coefficient * term_2.coefficient });
+		}
+	}
+	return Sparse(std::move(terms));
+}
+
+Sparse polynomial::operator+(const Sparse& p1, const Sparse& p2)
+{
+	std::vector<Sparse_Term> terms(p1.begin(), p1.end());
+	terms.insert(terms.end(), p2.begin(), p2.end());
+	return Sparse(std::move(terms));
+}
+
+Sparse polynomial::operator*(const Sparse& p, double factor)
+{
+	std::vector<Sparse_Term> terms(p.begin(), p.end());
+	for (Sparse_Term& term : terms) {
+		term.coefficient *= factor;
+	}
+	return Sparse(std::move(terms));
+}
+
+std::vector<Interval> sparse_root_isolation(const Sparse& p, const Interval& start_zone, double min_width)
+{
+	std::vector<Interval> result;
+	if (p.size() <= 1) {
+		if (p.size() == 1 && p.front().exponent > 0 && start_zone.min <= 0.0 && 0.0 <= start_zone.max) {
+			result.push_back(Interval{ 0.0, 0.0 });
+		}
+		return result;
+	}
+	const double bound = sparse::root_bound(p);
+
+	//negative roots are the positive roots of p(-x)
+	if (start_zone.min < 0.0) {
+		const Interval zone = { std::max(0.0, -start_zone.max), std::min(bound, -start_zone.min) };
+		if (zone.min < zone.max || (zone.min == zone.max && zone.min > 0.0)) {
+			std::vector<Interval> negative = sparse::closed_positive_roots(reflect(p), zone, min_width);
+			for (auto root = negative.rbegin(); root != negative.rend(); ++root) {
+				result.push_back(Interval{ -root->max, -root->min });
+			}
+		}
+	}
+	if (p.front().exponent > 0 && start_zone.min <= 0.0 && 0.0 <= start_zone.max) {
+		result.push_back(Interval{ 0.0, 0.0 });
+	}
+	if (start_zone.max > 0.0) {
+		const Interval zone = { std::max(0.0, start_zone.min), std::min(bound, start_zone.max) };
+		if (zone.min < zone.max || (zone.min == zone.max && zone.min > 0.0)) {
+			const std::vector<Interval> positive = sparse::closed_positive_roots(p, zone, min_width);
+			result.insert(result.end(), positive.begin(), positive.end());
+		}
+	}
+	return result;
+}
@@ -0,0 +1,61 @@
+#pragma once
+
+#include <cstdint>
+#include <vector>
+#include <initializer_list>
+
+#include "descartes.hpp"
+
+namespace polynomial {
+
+	struct Sparse_Term
+	{
+		std::uint64_t exponent;
+		double coefficient;
+	};
+
+	//\sum_i terms[i].coefficient * x^terms[i].exponent, stored by ascending exponent without zero coefficients
+	//(there are no two terms with the same exponent). the zero polynomial has no terms at all.
+	//memory and the cost of all operations below depend on the number of terms, not on the degree
+	struct Sparse
+		:public std::vector<Sparse_Term>
+	{
+		Sparse() = default;
+
+		//terms may come in any order, equal exponents are added up and zero coefficients removed
+		Sparse(std::vector<Sparse_Term> terms);
+		Sparse(std::initializer_list<Sparse_Term> terms) :Sparse(std::vector<Sparse_Term>(terms)) {}
+
+		std::uint64_t degree() const { return this->empty() ? 0 : this->back().exponent; }
+	};
+
+	Sparse to_sparse(const Monomials& p);
+	Monomials to_dense(const Sparse& p);
+
+	//the powers of x are computed by repeated squaring from one term to the next, O(terms * log(degree)).
+	//overflows to inf where the value exceeds double, see sign_at
+	double evaluate(const Sparse& p, double x);
+
+	//sign of p(x) (-1, 0 or 1), also where p(x) itself would overflow: every term is evaluated as logarithm
+	//and the sum is scaled by the biggest term. for x == 0 the sign of the lowest term is returned (the limit from the right)
+	int sign_at(const Sparse& p, double x);
+
+	Sparse derive(const Sparse& p);
+
+	//p(-x)
+	Sparse reflect(const Sparse& p);
+
+	Sparse operator*(const Sparse& p1, const Sparse& p2);
+	Sparse operator+(const Sparse& p1, const Sparse& p2);
+	Sparse operator*(const Sparse& p, double factor);
+
+} //namespace polynomial
+
+//isolating intervals of all real roots of p in start_zone in ascending order, refined to be at most min_width wide.
+//p has at most as many positive (negative) roots as its coefficients (of p(-x)) have sign changes, i.e. less than terms.
+//this is used via rolle: the roots of (x^-e * p)' with e the lowest exponent of p (one term less) split the positive axis
+//into parts where p is monotone, so each part holds at most one root, found by its sign change.
+//recursively this costs O(terms^3 * log(degree)) instead of depending on the degree.
+//roots hit exactly (e.g. 0 if the lowest exponent is positive, or a root at an end of start_zone) are returned as intervals of width 0.
+//roots of even multiplicity have no sign change and are not found.
+std::vector<Interval> sparse_root_isolation(const polynomial::Sparse& p, const Interval& start_zone, double min_width = 0.000001);
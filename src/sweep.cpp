@@ -0,0 +1,148 @@
+#include "sweep.hpp"
+
+#include <thread>
+#include <limits>
+#include <algorithm>
+#include <cmath>
+
+using namespace polynomial;
+
+polynomial::Monomials Sweep_Grid::at(std::size_t step) const
+{
+	const auto first = this->coefficients.begin() + step * this->size;
+	return Monomials(std::vector<double>(first, first + this->size));
+}
+
+Sweep_Grid sample_grid(const std::vector<std::function<double(double)>>& coefficient_functions, const std::vector<double>& parameters)
+{
+	Sweep_Grid grid = { parameters, coefficient_functions.size(), {} };
+	grid.coefficients.reserve(parameters.size() * grid.size);
+	for (const double t : parameters) {
+		for (const auto& coefficient : coefficient_functions) {
+			grid.coefficients.push_back(coefficient(t));
+		}
+	}
+	return grid;
+}
+
+namespace sweep {
+
+	double midpoint(const Interval& i) { return (i.min / 2) + (i.max / 2); }
+
+	//order preserving matching of the roots of two neighbouring steps (roots never cross without merging first).
+	//every root of the smaller side is matched, such that the sum of the distances between matched midpoints is minimal.
+	//result[i] is the index in current matched to previous[i], or no_match
+	constexpr std::size_t no_match = std::numeric_limits<std::size_t>::max();
+
+	std::vector<std::size_t> match(const std::vector<Interval>& previous, const std::vector<Interval>& current)
+	{
+		const bool previous_smaller = previous.size() <= current.size();
+		const std::vector<Interval>& small = previous_smaller ? previous : current;
+		const std::vector<Interval>& large = previous_smaller ? current : previous;
+		const std::size_t m = small.size();
+		const std::size_t n = large.size();
+
+		//cost[i * (n + 1) + j]: best matching of the first i of small into the first j of large
+		constexpr double infinity = std::numeric_limits<double>::infinity();
+		std::vector<double> cost((m + 1) * (n + 1), infinity);
+		for (std::size_t j = 0; j <= n; j++) {
+			cost[j] = 0.0;
+		}
+		for (std::size_t i = 1; i <= m; i++) {
+			for (std::size_t j = i; j <= n; j++) {
+				const double skip = cost[i * (n + 1) + j - 1];
+				const double take = cost[(i - 1) * (n + 1) + j - 1] + std::abs(midpoint(small[i - 1]) - midpoint(large[j - 1]));
+				cost[i * (n + 1) + j] = std::min(skip, take);
+			}
+		}
+
+		std::vector<std::size_t> small_to_large(m, no_match);
+		for (std::size_t i = m, j = n; i > 0; j--) {
+			if (cost[i * (n + 1) + j] != cost[i * (n + 1) + j - 1]) {	//small[i - 1] is matched with large[j - 1]
+				small_to_large[i - 1] = j - 1;
+				i--;
+			}
+		}
+
+		if (previous_smaller) {
+			return small_to_large;
+		}
+		std::vector<std::size_t> result(previous.size(), no_match);
+		for (std::size_t i = 0; i < m; i++) {
+			result[small_to_large[i]] = i;
+		}
+		return result;
+	}
+
+	//isolates steps [first, last), each step is seeded with the frontier of the step before
+	void isolate_chunk(const Sweep_Grid& grid, const Interval& start_zone, std::size_t first, std::size_t last,
+		bool(*accept)(const Monomials& p, const Interval& i), std::vector<std::vector<Interval>>& roots)
+	{
+		Isolation_Frontier frontier;
+		for (std::size_t step = first; step < last; step++) {
+			const Monomials p = grid.at(step);
+			frontier = step == first ? descartes_frontier(p, start_zone, accept) : repair_frontier(p, frontier, accept);
+			roots[step] = root_intervals(frontier);
+		}
+	}
+
+} //namespace sweep
+
+Sweep_Result parametric_sweep(const Sweep_Grid& grid, const Interval& start_zone, std::size_t threads,
+	bool(*accept)(const Monomials& p, const Interval& i))
+{
+	const std::size_t steps = grid.steps();
+	std::vector<std::vector<Interval>> roots(steps);
+
+	if (threads == 0) {
+		threads = std::max(1u, std::thread::hardware_concurrency());
+	}
+	threads = std::min(threads, std::max<std::size_t>(steps, 1));
+	{
+		std::vector<std::thread> workers;
+		workers.reserve(threads);
+		for (std::size_t chunk = 0; chunk < threads; chunk++) {
+			const std::size_t first = steps * chunk / threads;
+			const std::size_t last = steps * (chunk + 1) / threads;
+			workers.emplace_back(sweep::isolate_chunk, std::cref(grid), std::cref(start_zone), first, last, accept, std::ref(roots));
+		}
+		for (auto& worker : workers) {
+			worker.join();
+		}
+	}
+
+	//assign tracks step by step
+	Sweep_Result result = { steps, 0, {}, {} };
+	std::vector<std::vector<std::size_t>> tracks(steps);
+	for (std::size_t step = 0; step < steps; step++) {
+		tracks[step].assign(roots[step].size(), sweep::no_match);
+		if (step > 0) {
+			const std::vector<std::size_t> matches = sweep::match(roots[step - 1], roots[step]);
+			for (std::size_t i = 0; i < matches.size(); i++) {
+				if (matches[i] == sweep::no_match) {
+					result.events.push_back(Sweep_Event{ Sweep_Event_Kind::death, step, tracks[step - 1][i] });
+				}
+				else {
+					tracks[step][matches[i]] = tracks[step - 1][i];
+				}
+			}
+		}
+		for (std::size_t j = 0; j < tracks[step].size(); j++) {
+			if (tracks[step][j] == sweep::no_match) {
+				tracks[step][j] = result.tracks++;
+				if (step > 0) {
+					result.events.push_back(Sweep_Event{ Sweep_Event_Kind::birth, step, tracks[step][j] });
+				}
+			}
+		}
+	}
+
+	constexpr double nan = std::numeric_limits<double>::quiet_NaN();
+	result.trajectories.assign(steps * result.tracks, Interval{ nan, nan });
+	for (std::size_t step = 0; step < steps; step++) {
+		for (std::size_t j = 0; j < roots[step].size(); j++) {
+			result.trajectories[step * result.tracks + tracks[step][j]] = roots[step][j];
+		}
+	}
+	return result;
+}
@@ -0,0 +1,54 @@
+#pragma once
+
+#include <vector>
+#include <functional>
+
+#include "descartes.hpp"
+
+//root isolation for a family p(x; t) over a grid of parameter values t.
+//neighbouring parameter values are isolated in parallel chunks, inside a chunk every step starts from the frontier
+//of the step before (see repair_frontier). afterwards the roots of neighbouring steps are matched to trajectories.
+
+//coefficient matrix over the parameter grid: coefficients[step * size + i] belongs to x^i at parameters[step]
+struct Sweep_Grid
+{
+	std::vector<double> parameters;
+	std::size_t size;	//degree + 1
+	std::vector<double> coefficients;
+
+	std::size_t steps() const { return this->parameters.size(); }
+	polynomial::Monomials at(std::size_t step) const;
+};
+
+//coefficient_functions[i](t) is the coefficient of x^i at parameter t
+Sweep_Grid sample_grid(const std::vector<std::function<double(double)>>& coefficient_functions, const std::vector<double>& parameters);
+
+enum class Sweep_Event_Kind
+{
+	birth,	//track has a root at step, but not at step - 1
+	death,	//track has a root at step - 1, but not at step
+};
+
+struct Sweep_Event
+{
+	Sweep_Event_Kind kind;
+	std::size_t step;
+	std::size_t track;
+};
+
+struct Sweep_Result
+{
+	std::size_t steps;
+	std::size_t tracks;
+	//trajectories[step * tracks + track] is the interval of the root of track at step,
+	//both ends are NaN if the track has no root at this step
+	std::vector<Interval> trajectories;
+	std::vector<Sweep_Event> events;	//ordered by step
+
+	const Interval& at(std::size_t step, std::size_t track) const { return this->trajectories[step * this->tracks + track]; }
+	static bool present(const Interval& i) { return i.min == i.min; }	//false for NaN
+};
+
+//threads == 0 uses std::thread::hardware_concurrency()
+Sweep_Result parametric_sweep(const Sweep_Grid& grid, const Interval& start_zone, std::size_t threads = 0,
+	bool(*accept)(const polynomial::Monomials& p, const Interval& i) = default_accept);
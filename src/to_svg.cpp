@@ -50,7 +50,7 @@ RGB HSV::to_rgb() const
 
 
 SVG::SVG(const std::string& name, Vec2D view_box_min, Vec2D view_box_max)
-	:document(name)
+	:name(name)
 {
 	this->document << "<!DOCTYPE html>\n";
 	this->document << "<svg xmlns=\"http://www.w3.org/2000/svg\" viewBox=\"" 
@@ -60,7 +60,8 @@ SVG::SVG(const std::string& name, Vec2D view_box_min, Vec2D view_box_max)
 SVG::~SVG()
 {
 	this->document << "</svg>\n";
-	this->document.close();
+	std::ofstream file(this->name);
+	file << this->document.view();
 }
 
 void SVG::add_line(Vec2D start, Vec2D end, const SVG::Style& style)
@@ -2,6 +2,7 @@
 
 #include <string>
 #include <fstream>
+#include <sstream>
 #include <vector>
 
 constexpr double pi = 3.14159265358979323846264338327950288419716939937510582097494;
@@ -202,7 +203,8 @@ public:
 	void add_text(Vec2D position, const std::string& content, const Text_Style& style);
 
 private:
-	std::ofstream document;
+	std::string name;
+	std::ostringstream document;	//the whole file is buffered and written at once by the destructor
 };
 
 namespace svg_style {
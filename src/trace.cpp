@@ -0,0 +1,98 @@
+#include "trace.hpp"
+
+#include <thread>
+#include <algorithm>
+#include <fstream>
+#include <unordered_map>
+
+Subdivision_Trace::Subdivision_Trace(std::size_t capacity)
+	:records(std::max<std::size_t>(capacity, 1)), recorded(0), start(std::chrono::steady_clock::now())
+{}
+
+void Subdivision_Trace::record(const Interval& interval, std::size_t depth, std::size_t sign_variations, isolation::Decision decision) noexcept
+{
+	static thread_local const std::uint64_t thread = std::hash<std::thread::id>{}(std::this_thread::get_id());
+	const auto now = std::chrono::steady_clock::now();
+	const std::uint64_t index = this->recorded.fetch_add(1, std::memory_order_relaxed);
+	this->records[index % this->records.size()] = Trace_Record{
+		interval,
+		static_cast<std::uint32_t>(depth),
+		static_cast<std::uint32_t>(sign_variations),
+		decision,
+		thread,
+		std::chrono::duration_cast<std::chrono::nanoseconds>(now - this->start).count()
+	};
+}
+
+std::size_t Subdivision_Trace::size() const
+{
+	return std::min<std::uint64_t>(this->recorded.load(), this->records.size());
+}
+
+std::size_t Subdivision_Trace::overwritten() const
+{
+	return this->recorded.load() - this->size();
+}
+
+std::vector<Trace_Record> Subdivision_Trace::snapshot() const
+{
+	const std::uint64_t recorded_ = this->recorded.load();
+	const std::uint64_t first = recorded_ - this->size();
+	std::vector<Trace_Record> result;
+	result.reserve(this->size());
+	for (std::uint64_t i = first; i < recorded_; i++) {
+		result.push_back(this->records[i % this->records.size()]);
+	}
+	return result;
+}
+
+void Subdivision_Trace::clear()
+{
+	this->recorded = 0;
+	this->start = std::chrono::steady_clock::now();
+}
+
+void Subdivision_Trace::write_chrome_trace(const std::string& file_name) const
+{
+	const auto decision_name = [](isolation::Decision decision) {
+		switch (decision) {
+		case isolation::Decision::discard: return "discard";
+		case isolation::Decision::root:    return "root";
+		case isolation::Decision::split:   return "split";
+		}
+		return "";
+	};
+
+	std::ofstream document(file_name);
+	document.precision(17);
+	document << "{\"displayTimeUnit\":\"ns\",\"traceEvents\":[";
+
+	//trace event format counts time in microseconds
+	const auto microseconds = [](std::int64_t nanoseconds) {
+		const std::string fraction = std::to_string(1000 + nanoseconds % 1000);
+		return std::to_string(nanoseconds / 1000) + "." + fraction.substr(1);
+	};
+
+	//threads are numbered in order of appearance
+	struct Thread_State
+	{
+		std::size_t number;
+		std::int64_t last_record;
+	};
+	std::unordered_map<std::uint64_t, Thread_State> threads;
+	bool first = true;
+	for (const Trace_Record& record : this->snapshot()) {
+		const auto thread = threads.try_emplace(record.thread, Thread_State{ threads.size(), 0 }).first;
+		const std::int64_t begin = thread->second.last_record;
+		thread->second.last_record = record.nanoseconds;
+
+		document << (first ? "\n" : ",\n");
+		first = false;
+		document << "{\"name\":\"" << decision_name(record.decision) << "\",\"cat\":\"subdivision\",\"ph\":\"X\""
+			<< ",\"pid\":0,\"tid\":" << thread->second.number
+			<< ",\"ts\":" << microseconds(begin) << ",\"dur\":" << microseconds(record.nanoseconds - begin)
+			<< ",\"args\":{\"min\":" << record.interval.min << ",\"max\":" << record.interval.max
+			<< ",\"depth\":" << record.depth << ",\"sign_variations\":" << record.sign_variations << "}}";
+	}
+	document << "\n]}\n";
+}
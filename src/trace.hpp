@@ -0,0 +1,63 @@
+#pragma once
+
+#include <vector>
+#include <atomic>
+#include <chrono>
+#include <cstdint>
+#include <string>
+
+#include "isolation_engine.hpp"
+
+//one node of the subdivision tree, as seen by the statistics policy of isolation::Engine
+struct Trace_Record
+{
+	Interval interval;
+	std::uint32_t depth;
+	std::uint32_t sign_variations;
+	isolation::Decision decision;
+	std::uint64_t thread;		//hash of std::this_thread::get_id()
+	std::int64_t nanoseconds;	//since construction (or last clear()) of the trace
+};
+
+//records the subdivision of descartes_root_isolation (pass a pointer as last argument).
+//all memory is allocated up front, recording is a single atomic increment and a copy into a ring buffer,
+//so tracing barely changes the timings it captures. if more nodes than capacity are recorded, the oldest are overwritten.
+//records may be added from several threads at once, reading is only allowed while no isolation is running.
+class Subdivision_Trace
+{
+private:
+	std::vector<Trace_Record> records;
+	std::atomic<std::uint64_t> recorded;	//total number of calls to record
+	std::chrono::steady_clock::time_point start;
+
+public:
+	explicit Subdivision_Trace(std::size_t capacity = 1 << 16);
+
+	void record(const Interval& interval, std::size_t depth, std::size_t sign_variations, isolation::Decision decision) noexcept;
+
+	std::size_t capacity() const { return this->records.size(); }
+	std::size_t size() const;
+	std::size_t overwritten() const;	//records lost because the ring buffer was full
+
+	//all records still in the buffer, oldest first
+	std::vector<Trace_Record> snapshot() const;
+	void clear();
+
+	//writes the records as trace event format, which can be opened with chrome://tracing or ui.perfetto.dev.
+	//every node becomes a complete event lasting from the previous record of the same thread (or the start of the trace) to its own record.
+	void write_chrome_trace(const std::string& file_name) const;
+};
+
+namespace isolation {
+
+	//statistics policy forwarding every node to a Subdivision_Trace
+	struct Tracing_Statistics
+	{
+		Subdivision_Trace* trace;
+
+		void record(const Interval& interval, std::size_t depth, std::size_t sign_variations, Decision decision) {
+			this->trace->record(interval, depth, sign_variations, decision);
+		}
+	};
+
+} //namespace isolation